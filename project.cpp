@@ -1,8 +1,19 @@
 #include <iostream>
 #include <string>
 #include <cstdlib>
+#include <cmath>
 #include <ctime>
 #include <fstream>
+#include <cstring>
+#include <cstddef>
+#include <cstdio>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <chrono>
 // NO <vector>, NO <unordered_map>, NO <queue> (for heap)
 using namespace std;
 
@@ -86,9 +97,10 @@ public:
 
 
 // Using an array of linked lists for collision handling. O(1) average lookup.
-class TeamHashTable {
+// TABLE_SIZE is a compile-time parameter so specialized builds can size it.
+template <int TABLE_SIZE>
+class BasicTeamHashTable {
 private:
-    static const int TABLE_SIZE = 101; // Prime number for better distribution
     LinkedList buckets[TABLE_SIZE]; // Array of Linked Lists
 
     // Simple Hash Function: Sum of ASCII values % TABLE_SIZE
@@ -132,6 +144,14 @@ public:
         return NULL; // Not found
     }
 
+    const Team* find(const string& name) const {
+        return const_cast<BasicTeamHashTable*>(this)->find(name);
+    }
+
+    // Read-only walk over the buckets, for callers that must not copy
+    static int bucketCount() { return TABLE_SIZE; }
+    const Node* chainAt(int bucket) const { return buckets[bucket].head; }
+
     // Convert all teams to a dynamic array (Needed for Leaderboard/Heap)
     void toArray(Team*& arr, int& size) {
         // First, count all teams
@@ -156,6 +176,8 @@ public:
     }
 };
 
+typedef BasicTeamHashTable<101> TeamHashTable; // Prime number for better distribution
+
 class Queue {
 public:
     struct QNode {
@@ -267,6 +289,20 @@ public:
         if (!root) cout << "No results." << endl;
         else inorder(root);
     }
+
+    int count(BNode* r) const {
+        return r ? 1 + count(r->left) + count(r->right) : 0;
+    }
+
+    // Inorder copy of every result into parallel arrays
+    void collect(BNode* r, string* w, string* l, int& idx) const {
+        if (!r) return;
+        collect(r->left, w, l, idx);
+        w[idx] = r->win;
+        l[idx] = r->lose;
+        idx++;
+        collect(r->right, w, l, idx);
+    }
 };
 
 
@@ -328,24 +364,311 @@ public:
 };
 
 
+// FNV-1a string hash. Spreads names far better than the ASCII sum used by
+// TeamHashTable, so shards and name indexes stay balanced.
+unsigned int stringHash(const string& key) {
+    unsigned int h = 2166136261u;
+    for (char ch : key) {
+        h ^= (unsigned char)ch;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+
+// Open-addressing map from team name to a dense integer id (linear probing).
+class NameIndexMap {
+private:
+    string* keys;
+    int* values;
+    bool* used;
+    int capacity;
+    int count;
+
+    int slotOf(const string& key) const {
+        int slot = stringHash(key) & (capacity - 1);
+        while (used[slot] && keys[slot] != key) slot = (slot + 1) & (capacity - 1);
+        return slot;
+    }
+
+    void rehash(int newCapacity) {
+        string* oldKeys = keys;
+        int* oldValues = values;
+        bool* oldUsed = used;
+        int oldCapacity = capacity;
+
+        capacity = newCapacity;
+        keys = new string[capacity];
+        values = new int[capacity];
+        used = new bool[capacity];
+        for (int i = 0; i < capacity; ++i) used[i] = false;
+
+        for (int i = 0; i < oldCapacity; ++i) {
+            if (!oldUsed[i]) continue;
+            int slot = slotOf(oldKeys[i]);
+            used[slot] = true;
+            keys[slot] = oldKeys[i];
+            values[slot] = oldValues[i];
+        }
+        delete[] oldKeys;
+        delete[] oldValues;
+        delete[] oldUsed;
+    }
+
+public:
+    NameIndexMap(int initialCapacity = 16) : capacity(1), count(0) {
+        while (capacity < initialCapacity) capacity *= 2; // Power of two for masking
+        keys = new string[capacity];
+        values = new int[capacity];
+        used = new bool[capacity];
+        for (int i = 0; i < capacity; ++i) used[i] = false;
+    }
+    ~NameIndexMap() {
+        delete[] keys;
+        delete[] values;
+        delete[] used;
+    }
+
+    int size() const { return count; }
+
+    // Returns -1 if the name is unknown
+    int get(const string& key) const {
+        int slot = slotOf(key);
+        return used[slot] ? values[slot] : -1;
+    }
+
+    void put(const string& key, int value) {
+        if ((count + 1) * 2 > capacity) rehash(capacity * 2); // Keep load <= 0.5
+        int slot = slotOf(key);
+        if (!used[slot]) {
+            used[slot] = true;
+            keys[slot] = key;
+            count++;
+        }
+        values[slot] = value;
+    }
+
+    void clear() {
+        for (int i = 0; i < capacity; ++i) {
+            used[i] = false;
+            keys[i].clear();
+        }
+        count = 0;
+    }
+};
+
+
+// Aggregated head-to-head records per ordered pair (winner id, loser id).
+// Pairs between the first DENSE_LIMIT ids live in a dense block (small fields
+// never touch the hash); all other pairs live in a hashed sparse matrix.
+// Each team also keeps a list of distinct opponents for O(degree) enumeration.
+class HeadToHead {
+public:
+    struct OppNode {
+        int opponent;
+        OppNode* next;
+        OppNode(int o) : opponent(o), next(NULL) {}
+    };
+
+private:
+    static const int DENSE_LIMIT = 64;
+    int dense[DENSE_LIMIT][DENSE_LIMIT]; // dense[a][b] = times a beat b
+
+    struct PairEntry {
+        int a, b, wins; // a == -1 marks an empty slot
+    };
+    PairEntry* table;
+    int capacity;
+    int count;
+
+    OppNode** opponents;
+    int oppCapacity;
+
+    int slotOf(int a, int b) const {
+        unsigned int h = (unsigned int)a * 2654435761u ^ ((unsigned int)b + 0x9e3779b9u) * 40503u;
+        int slot = h & (capacity - 1);
+        while (table[slot].a != -1 && (table[slot].a != a || table[slot].b != b))
+            slot = (slot + 1) & (capacity - 1);
+        return slot;
+    }
+
+    void grow() {
+        PairEntry* old = table;
+        int oldCapacity = capacity;
+        capacity *= 2;
+        table = new PairEntry[capacity];
+        for (int i = 0; i < capacity; ++i) table[i].a = -1;
+        for (int i = 0; i < oldCapacity; ++i) {
+            if (old[i].a == -1) continue;
+            table[slotOf(old[i].a, old[i].b)] = old[i];
+        }
+        delete[] old;
+    }
+
+    // Pointer to the counter for "a beat b", creating it if asked
+    int* counter(int a, int b, bool create) {
+        if (a < DENSE_LIMIT && b < DENSE_LIMIT) return &dense[a][b];
+        if (create && (count + 1) * 2 > capacity) grow();
+        int slot = slotOf(a, b);
+        if (table[slot].a == -1) {
+            if (!create) return NULL;
+            table[slot].a = a;
+            table[slot].b = b;
+            table[slot].wins = 0;
+            count++;
+        }
+        return &table[slot].wins;
+    }
+
+    void ensureTeam(int id) {
+        if (id < oppCapacity) return;
+        int newCapacity = oppCapacity * 2;
+        while (newCapacity <= id) newCapacity *= 2;
+        OppNode** bigger = new OppNode*[newCapacity];
+        for (int i = 0; i < oppCapacity; ++i) bigger[i] = opponents[i];
+        for (int i = oppCapacity; i < newCapacity; ++i) bigger[i] = NULL;
+        delete[] opponents;
+        opponents = bigger;
+        oppCapacity = newCapacity;
+    }
+
+    void linkOpponent(int a, int b) {
+        OppNode* n = new OppNode(b);
+        n->next = opponents[a];
+        opponents[a] = n;
+    }
+
+    void unlinkOpponent(int a, int b) {
+        OppNode** link = &opponents[a];
+        while (*link) {
+            if ((*link)->opponent == b) {
+                OppNode* dead = *link;
+                *link = dead->next;
+                delete dead;
+                return;
+            }
+            link = &(*link)->next;
+        }
+    }
+
+public:
+    HeadToHead() : capacity(64), count(0), oppCapacity(16) {
+        for (int i = 0; i < DENSE_LIMIT; ++i)
+            for (int j = 0; j < DENSE_LIMIT; ++j) dense[i][j] = 0;
+        table = new PairEntry[capacity];
+        for (int i = 0; i < capacity; ++i) table[i].a = -1;
+        opponents = new OppNode*[oppCapacity];
+        for (int i = 0; i < oppCapacity; ++i) opponents[i] = NULL;
+    }
+    ~HeadToHead() {
+        for (int i = 0; i < oppCapacity; ++i) {
+            OppNode* current = opponents[i];
+            while (current) {
+                OppNode* next = current->next;
+                delete current;
+                current = next;
+            }
+        }
+        delete[] opponents;
+        delete[] table;
+    }
+
+    // Number of times a beat b. O(1).
+    int wins(int a, int b) const {
+        if (a < DENSE_LIMIT && b < DENSE_LIMIT) return dense[a][b];
+        int slot = slotOf(a, b);
+        return (table[slot].a == -1) ? 0 : table[slot].wins;
+    }
+
+    // Returns the new "winner beat loser" count
+    int recordWin(int winner, int loser) {
+        ensureTeam(winner > loser ? winner : loser);
+        bool firstMeeting = (wins(winner, loser) == 0 && wins(loser, winner) == 0);
+        int* c = counter(winner, loser, true);
+        (*c)++;
+        if (firstMeeting) {
+            linkOpponent(winner, loser);
+            linkOpponent(loser, winner);
+        }
+        return *c;
+    }
+
+    // Reverses one win. Returns the remaining count (0 if there was nothing).
+    int removeWin(int winner, int loser) {
+        int* c = counter(winner, loser, false);
+        if (!c || *c == 0) return 0;
+        (*c)--;
+        if (*c == 0 && wins(loser, winner) == 0) {
+            unlinkOpponent(winner, loser);
+            unlinkOpponent(loser, winner);
+        }
+        return *c;
+    }
+
+    // Distinct opponents of a team (either result). O(degree) to walk.
+    OppNode* opponentsOf(int id) const {
+        return (id >= 0 && id < oppCapacity) ? opponents[id] : NULL;
+    }
+};
+
+
 class Graph {
 private:
+    // One edge per distinct (winner, loser) pair; repeat wins only bump the
+    // head-to-head counter.
     struct DefeatNode {
         string loserName;
+        int loserIdx;
         DefeatNode* next;
-        DefeatNode(const string& name) : loserName(name), next(NULL) {}
+        DefeatNode(const string& name, int idx) : loserName(name), loserIdx(idx), next(NULL) {}
     };
 
     DefeatNode** adjList; // Dynamic array of DefeatNode pointers
     string* teamNames;    // Array to map index to team name
     int maxTeams;         
     int teamCount;        
+    NameIndexMap nameIndex; // Name -> index, O(1) average
+    HeadToHead h2h;
 
-    int getIndex(const string& name) const {
-        for (int i = 0; i < teamCount; ++i) {
-            if (teamNames[i] == name) return i;
+public:
+    // One head-to-head change, logged so consumers (PowerRanker) can stay
+    // in sync without rescanning the adjacency lists
+    struct EdgeChange {
+        int winner, loser, delta;
+    };
+
+    // Past this many unconsumed changes the log is dropped and the consumer
+    // rebuilds from buildCSR instead
+    static const int CHANGE_LOG_LIMIT = 1 << 16;
+
+private:
+    EdgeChange* changes;
+    int changeCount;
+    int changeCapacity;
+    bool trackingChanges; // Only after a consumer has synced; off again on overflow
+
+    void logChange(int winner, int loser, int delta) {
+        if (!trackingChanges) return;
+        if (changeCount == CHANGE_LOG_LIMIT) {
+            trackingChanges = false;
+            changeCount = 0;
+            return;
         }
-        return -1;
+        if (changeCount == changeCapacity) {
+            changeCapacity = changeCapacity ? changeCapacity * 2 : 64;
+            EdgeChange* bigger = new EdgeChange[changeCapacity];
+            for (int i = 0; i < changeCount; ++i) bigger[i] = changes[i];
+            if (changes) delete[] changes;
+            changes = bigger;
+        }
+        changes[changeCount].winner = winner;
+        changes[changeCount].loser = loser;
+        changes[changeCount].delta = delta;
+        changeCount++;
+    }
+
+    int getIndex(const string& name) const {
+        return nameIndex.get(name);
     }
 
     void resizeArrays(int newSize) {
@@ -376,8 +699,8 @@ private:
 
         DefeatNode* current = adjList[currentIdx];
         while (current) {
-            int neighborIdx = getIndex(current->loserName);
-            if (neighborIdx != -1 && !visited[neighborIdx]) {
+            int neighborIdx = current->loserIdx;
+            if (!visited[neighborIdx]) {
                 if (DFS_check(neighborIdx, targetIdx, visited)) return true;
             }
             current = current->next;
@@ -386,7 +709,9 @@ private:
     }
 
 public:
-    Graph(int initialSize = 10) : maxTeams(initialSize), teamCount(0) {
+    Graph(int initialSize = 10)
+        : maxTeams(initialSize), teamCount(0), changes(NULL), changeCount(0), changeCapacity(0),
+          trackingChanges(false) {
         adjList = new DefeatNode*[maxTeams];
         teamNames = new string[maxTeams];
         for (int i = 0; i < maxTeams; ++i) {
@@ -405,6 +730,7 @@ public:
         }
         delete[] adjList;
         delete[] teamNames;
+        if (changes) delete[] changes;
     }
 
     void addTeam(const string& name) {
@@ -414,6 +740,7 @@ public:
         }
         teamNames[teamCount] = name;
         adjList[teamCount] = NULL;
+        nameIndex.put(name, teamCount);
         teamCount++;
     }
 
@@ -424,14 +751,42 @@ public:
         addTeam(loser);
 
         int winnerIdx = getIndex(winner);
-        if (winnerIdx == -1) return; 
+        int loserIdx = getIndex(loser);
+        if (winnerIdx == -1 || loserIdx == -1) return; 
+
+        // Only the first win over this opponent creates an edge
+        int times = h2h.recordWin(winnerIdx, loserIdx);
+        logChange(winnerIdx, loserIdx, 1);
+        if (times > 1) return;
 
         // Add edge: winner -> loser
-        DefeatNode* newNode = new DefeatNode(loser);
+        DefeatNode* newNode = new DefeatNode(loser, loserIdx);
         newNode->next = adjList[winnerIdx];
         adjList[winnerIdx] = newNode;
     }
 
+    // Reverse one recorded win (used by undo). Drops the edge once the
+    // winner has no wins left over that opponent.
+    void removeMatch(const string& winner, const string& loser) {
+        int winnerIdx = getIndex(winner);
+        int loserIdx = getIndex(loser);
+        if (winnerIdx == -1 || loserIdx == -1) return;
+        if (h2h.wins(winnerIdx, loserIdx) == 0) return;
+        logChange(winnerIdx, loserIdx, -1);
+        if (h2h.removeWin(winnerIdx, loserIdx) > 0) return;
+
+        DefeatNode** link = &adjList[winnerIdx];
+        while (*link) {
+            if ((*link)->loserIdx == loserIdx) {
+                DefeatNode* dead = *link;
+                *link = dead->next;
+                delete dead;
+                return;
+            }
+            link = &(*link)->next;
+        }
+    }
+
     // ADDED: Missing showGraph function
     void showGraph() const {
         cout << endl << "=== PERFORMANCE GRAPH (Adjacency List) ===" << endl;
@@ -442,7 +797,10 @@ public:
                 cout << teamNames[i] << " defeated -> ";
                 DefeatNode* curr = adjList[i];
                 while (curr) {
-                    cout << curr->loserName << (curr->next ? ", " : "");
+                    int times = h2h.wins(i, curr->loserIdx);
+                    cout << curr->loserName;
+                    if (times > 1) cout << " (x" << times << ")";
+                    cout << (curr->next ? ", " : "");
                     curr = curr->next;
                 }
                 cout << endl;
@@ -471,136 +829,3380 @@ public:
         }
         delete[] visited;
     }
+
+    // A's record against B. O(1).
+    void showHeadToHead(const string& teamA, const string& teamB) const {
+        int idxA = getIndex(teamA);
+        int idxB = getIndex(teamB);
+        if (idxA == -1 || idxB == -1) return;
+        cout << "Head-to-head: " << teamA << " " << h2h.wins(idxA, idxB)
+             << " - " << h2h.wins(idxB, idxA) << " " << teamB << endl;
+    }
+
+    int size() const { return teamCount; }
+    // True when the log holds every change since the last trackChanges()
+    bool changesTracked() const { return trackingChanges; }
+    int pendingChanges() const { return changeCount; }
+    const EdgeChange& changeAt(int i) const { return changes[i]; }
+    // The consumer is in sync: empty the log and keep logging from here
+    void trackChanges() {
+        changeCount = 0;
+        trackingChanges = true;
+    }
+    int headToHeadWins(const string& a, const string& b) const {
+        int idxA = getIndex(a), idxB = getIndex(b);
+        return (idxA == -1 || idxB == -1) ? 0 : h2h.wins(idxA, idxB);
+    }
+    int indexOf(const string& name) const { return getIndex(name); }
+    const string& nameAt(int idx) const { return teamNames[idx]; }
+
+    // Export the defeat graph in CSR form: row w lists the teams w has beaten,
+    // with the number of wins over each as the edge weight.
+    void buildCSR(int*& rowStart, int*& cols, float*& weights) const {
+        rowStart = new int[teamCount + 1];
+        int edges = 0;
+        for (int i = 0; i < teamCount; ++i) {
+            rowStart[i] = edges;
+            for (DefeatNode* curr = adjList[i]; curr; curr = curr->next) edges++;
+        }
+        rowStart[teamCount] = edges;
+
+        cols = new int[edges > 0 ? edges : 1];
+        weights = new float[edges > 0 ? edges : 1];
+        int e = 0;
+        for (int i = 0; i < teamCount; ++i) {
+            for (DefeatNode* curr = adjList[i]; curr; curr = curr->next) {
+                cols[e] = curr->loserIdx;
+                weights[e] = (float)h2h.wins(i, curr->loserIdx);
+                e++;
+            }
+        }
+    }
+
+    // Every opponent a team has met, with its record against each. O(degree).
+    void showOpponents(const string& team) const {
+        int idx = getIndex(team);
+        if (idx == -1) {
+            cout << "Team not found in the graph." << endl;
+            return;
+        }
+        HeadToHead::OppNode* curr = h2h.opponentsOf(idx);
+        if (!curr) cout << team << " has not played anyone yet." << endl;
+        while (curr) {
+            cout << team << " vs " << teamNames[curr->opponent] << ": "
+                 << h2h.wins(idx, curr->opponent) << "-"
+                 << h2h.wins(curr->opponent, idx) << endl;
+            curr = curr->next;
+        }
+    }
 };
 
 
-class TournamentTree {
-public:
-    struct TNode {
-        string teamName;
-        TNode* left;
-        TNode* right;
-        TNode(string n) : teamName(n), left(NULL), right(NULL) {}
+// Sharded team index for parallel result ingestion.
+// Each shard owns its own TeamHashTable behind its own mutex, so threads
+// recording results for different teams rarely contend. Every update to a
+// team happens while holding its shard lock, which makes it linearizable.
+class ConcurrentTeamIndex {
+private:
+    // Teams never move or leave the index, so their addresses serve as ids
+    struct Edge {
+        const Team* winner;
+        const Team* loser;
     };
-    TNode* root;
 
-    TournamentTree() : root(NULL) {}
+    struct Shard {
+        TeamHashTable table;
+        mutex lock;
+        Edge* edges; // Defeat edges whose winner lives in this shard
+        int edgeCount;
+        int edgeCapacity;
+        Shard() : edges(NULL), edgeCount(0), edgeCapacity(0) {}
+    };
 
-    void printInorder(TNode* r) {
-        if (!r) return;
-        printInorder(r->left);
-        cout << r->teamName << " ";
-        printInorder(r->right);
+    static const int SHARD_COUNT = 64;
+    Shard shards[SHARD_COUNT];
+
+    int shardOf(const string& name) const {
+        return stringHash(name) % SHARD_COUNT;
     }
-};
 
+public:
+    ~ConcurrentTeamIndex() {
+        for (int i = 0; i < SHARD_COUNT; ++i) {
+            if (shards[i].edges) delete[] shards[i].edges;
+        }
+    }
 
-void merge(Team arr[], int l, int m, int r) {
-    int i, j, k;
-    int n1 = m - l + 1;
-    int n2 = r - m;
+    void insert(const Team& t) {
+        Shard& s = shards[shardOf(t.name)];
+        lock_guard<mutex> guard(s.lock);
+        s.table.insert(t);
+    }
 
-    Team* L = new Team[n1];
-    Team* R = new Team[n2];
+    // Copies the team out under its lock. No raw pointer escapes the shard.
+    bool get(const string& name, Team& out) {
+        Shard& s = shards[shardOf(name)];
+        lock_guard<mutex> guard(s.lock);
+        Team* t = s.table.find(name);
+        if (!t) return false;
+        out = *t;
+        return true;
+    }
 
-    for (i = 0; i < n1; i++) L[i] = arr[l + i];
-    for (j = 0; j < n2; j++) R[j] = arr[m + 1 + j];
+    // Record "winner defeated loser" atomically for both teams.
+    // Shard locks are always taken in index order to avoid deadlock.
+    bool recordResult(const string& winner, const string& loser, float ratingChange) {
+        bool isBye = (loser == "bye");
+        int a = shardOf(winner);
+        int b = isBye ? a : shardOf(loser);
+        int first = (a < b) ? a : b;
+        int second = (a < b) ? b : a;
+
+        shards[first].lock.lock();
+        if (second != first) shards[second].lock.lock();
+
+        Team* w = shards[a].table.find(winner);
+        Team* l = isBye ? NULL : shards[b].table.find(loser);
+        bool ok = (w != NULL) && (isBye || l != NULL);
+
+        if (ok) {
+            w->wins++;
+            w->rating += ratingChange;
+            if (l) l->losses++;
+
+            if (!isBye) {
+                Shard& s = shards[a];
+                if (s.edgeCount == s.edgeCapacity) { // Amortized: doubles, never copies strings
+                    s.edgeCapacity = s.edgeCapacity ? s.edgeCapacity * 2 : 64;
+                    Edge* bigger = new Edge[s.edgeCapacity];
+                    for (int i = 0; i < s.edgeCount; ++i) bigger[i] = s.edges[i];
+                    if (s.edges) delete[] s.edges;
+                    s.edges = bigger;
+                }
+                s.edges[s.edgeCount].winner = w;
+                s.edges[s.edgeCount].loser = l;
+                s.edgeCount++;
+            }
+        }
 
-    i = 0; j = 0; k = l;
-    while (i < n1 && j < n2) {
-        if (L[i].rating >= R[j].rating) { 
-            arr[k] = L[i];
-            i++;
-        } else {
-            arr[k] = R[j];
-            j++;
+        if (second != first) shards[second].lock.unlock();
+        shards[first].lock.unlock();
+        return ok;
+    }
+
+    int pendingEdges() {
+        int total = 0;
+        for (int i = 0; i < SHARD_COUNT; ++i) {
+            lock_guard<mutex> guard(shards[i].lock);
+            total += shards[i].edgeCount;
         }
-        k++;
+        return total;
     }
 
-    while (i < n1) { arr[k] = L[i]; i++; k++; }
-    while (j < n2) { arr[k] = R[j]; j++; k++; }
-    
-    delete[] L;
-    delete[] R;
+    // Move the buffered defeat edges into the (single-threaded) Graph.
+    // Each shard's buffer is detached under its lock and replayed outside it.
+    int drainEdges(Graph& g) {
+        int moved = 0;
+        for (int i = 0; i < SHARD_COUNT; ++i) {
+            Edge* list;
+            int count;
+            {
+                lock_guard<mutex> guard(shards[i].lock);
+                list = shards[i].edges;
+                count = shards[i].edgeCount;
+                shards[i].edges = NULL;
+                shards[i].edgeCount = 0;
+                shards[i].edgeCapacity = 0;
+            }
+            for (int k = 0; k < count; ++k) g.addMatch(list[k].winner->name, list[k].loser->name);
+            if (list) delete[] list;
+            moved += count;
+        }
+        return moved;
+    }
+};
+
+
+// Records `count` results starting at `from` into the shared index.
+void ingestSlice(ConcurrentTeamIndex* index, const string* names, const int* pairs,
+                 int from, int count, float ratingChange) {
+    for (int i = from; i < from + count; ++i) {
+        index->recordResult(names[pairs[2 * i]], names[pairs[2 * i + 1]], ratingChange);
+    }
 }
 
-void mergeSort(Team arr[], int l, int r) {
-    if (l < r) {
-        int m = l + (r - l) / 2;
-        mergeSort(arr, l, m);
-        mergeSort(arr, m + 1, r);
-        merge(arr, l, m, r);
+// Scaling benchmark: ingest the same random results with 1..64 threads.
+void benchmarkConcurrentIngestion(int teamCount, int matchCount) {
+    string* names = new string[teamCount];
+    for (int i = 0; i < teamCount; ++i) names[i] = "Team" + to_string(i);
+
+    int* pairs = new int[2 * matchCount];
+    for (int i = 0; i < matchCount; ++i) {
+        int a = rand() % teamCount;
+        int b = rand() % teamCount;
+        if (a == b) b = (b + 1) % teamCount;
+        pairs[2 * i] = a;
+        pairs[2 * i + 1] = b;
+    }
+
+    cout << endl << "=== PARALLEL INGESTION BENCHMARK ===" << endl;
+    cout << teamCount << " teams, " << matchCount << " results, "
+         << thread::hardware_concurrency() << " hardware threads" << endl;
+
+    double baseSeconds = 0;
+    for (int threads = 1; threads <= 64; threads *= 2) {
+        ConcurrentTeamIndex* index = new ConcurrentTeamIndex();
+        for (int i = 0; i < teamCount; ++i) index->insert(Team(names[i], 1000));
+
+        thread* workers = new thread[threads];
+        int perThread = matchCount / threads;
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int t = 0; t < threads; ++t) {
+            int from = t * perThread;
+            int count = (t == threads - 1) ? matchCount - from : perThread;
+            workers[t] = thread(ingestSlice, index, names, pairs, from, count, 1.5f);
+        }
+        for (int t = 0; t < threads; ++t) workers[t].join();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (threads == 1) baseSeconds = seconds;
+
+        // Sanity check: every result must have landed exactly once, both as
+        // a win and as a defeat edge
+        int recordedWins = 0;
+        Team tmp;
+        for (int i = 0; i < teamCount; ++i) {
+            if (index->get(names[i], tmp)) recordedWins += tmp.wins;
+        }
+        int buffered = index->pendingEdges();
+
+        chrono::steady_clock::time_point drainStart = chrono::steady_clock::now();
+        Graph graph(teamCount);
+        int drained = index->drainEdges(graph);
+        double drainMs = chrono::duration<double, milli>(chrono::steady_clock::now() - drainStart).count();
+
+        int* rowStart;
+        int* cols;
+        float* weights;
+        graph.buildCSR(rowStart, cols, weights);
+        long long edgeWins = 0;
+        for (int e = 0; e < rowStart[graph.size()]; ++e) edgeWins += (long long)weights[e];
+        delete[] rowStart;
+        delete[] cols;
+        delete[] weights;
+
+        bool consistent = recordedWins == matchCount && buffered == matchCount &&
+                          drained == matchCount && edgeWins == matchCount;
+        cout << "Threads: " << threads
+             << " | Time: " << seconds * 1000 << " ms"
+             << " | Results/sec: " << (long long)(matchCount / (seconds > 0 ? seconds : 1e-9))
+             << " | Speedup: " << (seconds > 0 ? baseSeconds / seconds : 0)
+             << " | Edge drain: " << drainMs << " ms"
+             << (consistent ? "" : " | MISMATCH") << endl;
+
+        delete[] workers;
+        delete index;
     }
+    cout << "====================================" << endl;
+
+    delete[] names;
+    delete[] pairs;
 }
 
 
-class Tournament {
-public:
-    LinkedList teamsLL; 
-    TeamHashTable teamsHT; 
-    Queue matches;
-    Stack undo; 
-    BST results; 
-    Graph performanceGraph; 
-    TournamentTree tourneyTree; 
-    float ratingBonus = 1.5;
+// Append-only rating history, one delta-encoded series per team id.
+// Each series is a list of small byte chunks carved out of one shared,
+// append-only arena. A chunk header is a checkpoint (round + absolute
+// rating); the bytes after it are varint-encoded (round gap, zigzag rating
+// delta in hundredths) pairs, usually 2-3 bytes per change. A team's first
+// chunk is tiny and each later one doubles up to MAX_CHUNK_BYTES, so a team
+// that never plays costs a few dozen bytes. "Rating after round R" = binary
+// search for the chunk, then replay at most one chunk of deltas.
+class RatingHistory {
+private:
+    static const int FIRST_CHUNK_BYTES = 12;
+    static const int MAX_CHUNK_BYTES = 120;
+    static const int MAX_EVENT_BYTES = 10; // Two 5-byte varints
+    static const int SLAB_BYTES = 64 * 1024;
+
+    struct Chunk {
+        int startRound;
+        int startCenti;
+        int lastRound;
+        int lastCenti;
+        unsigned char used;
+        unsigned char capacity;
+        unsigned char bytes[1]; // Really `capacity` bytes, allocated in the arena
+    };
 
-    Team* allTeamsArray = NULL; 
-    int currentTeamCount = 0;
+    struct Series {
+        Chunk* first;  // Most teams only ever need this one
+        Chunk** more;  // Chunks 1..chunkCount-1, also in the arena
+        int chunkCount;
+        int moreCapacity;
+    };
 
-    Tournament() {
-        tourneyTree.root = new TournamentTree::TNode("Champion");
+    Series* series;
+    int seriesCapacity;
+    long long eventCount;
+    long long chunkCount;
+
+    // Shared arena: fixed-size slabs that never move
+    unsigned char** slabs;
+    int slabCount;
+    int slabCapacity;
+    int slabUsed;
+    long long arenaBytes;
+
+    unsigned char* allocate(int bytes) {
+        bytes = (bytes + 7) & ~7; // Keep pointers and ints aligned
+        if (slabCount == 0 || slabUsed + bytes > SLAB_BYTES) {
+            if (slabCount == slabCapacity) {
+                int newCapacity = slabCapacity ? slabCapacity * 2 : 8;
+                unsigned char** bigger = new unsigned char*[newCapacity];
+                for (int i = 0; i < slabCount; ++i) bigger[i] = slabs[i];
+                if (slabs) delete[] slabs;
+                slabs = bigger;
+                slabCapacity = newCapacity;
+            }
+            slabs[slabCount++] = new unsigned char[SLAB_BYTES];
+            slabUsed = 0;
+        }
+        unsigned char* p = slabs[slabCount - 1] + slabUsed;
+        slabUsed += bytes;
+        arenaBytes += bytes;
+        return p;
     }
-    ~Tournament() {
-        if (allTeamsArray) delete[] allTeamsArray;
+
+    static Chunk* chunkAt(const Series& s, int i) { return i == 0 ? s.first : s.more[i - 1]; }
+
+    static void putVarint(unsigned char* out, int& pos, unsigned int v) {
+        while (v >= 0x80) {
+            out[pos++] = (unsigned char)(v | 0x80);
+            v >>= 7;
+        }
+        out[pos++] = (unsigned char)v;
     }
 
-    /* ----- REGISTRATION ----- */
-    void registerTeam(string n, float r) {
-        if (teamsHT.find(n)) { 
-            cout << "Team already exists." << endl;
-            return;
+    static unsigned int getVarint(const unsigned char* in, int& pos) {
+        unsigned int v = 0;
+        int shift = 0;
+        while (in[pos] & 0x80) {
+            v |= (unsigned int)(in[pos++] & 0x7F) << shift;
+            shift += 7;
         }
-        Team newTeam(n,r);
-        teamsHT.insert(newTeam); 
-        teamsLL.addTeam(newTeam); 
-        performanceGraph.addTeam(n); 
-        cout << n << " registered successfully." << endl;
+        v |= (unsigned int)in[pos++] << shift;
+        return v;
     }
 
-    /* ----- SHOW TEAMS ----- */
-    void showTeams() {
-        cout << endl << "=== REGISTERED TEAMS ===" << endl;
-        teamsLL.showAll();
-        cout << "=========================" << endl;
+    static int toCenti(float rating) {
+        return (int)(rating * 100 + (rating >= 0 ? 0.5f : -0.5f));
     }
 
-    /* ----- PREDICTION SYSTEM ----- */
-    void predictWinner() {
-        cout << endl << "=== WINNER PREDICTION SYSTEM ===" << endl;
-        if (teamsLL.countTeams() < 2) {
-            cout << "Not enough teams for prediction." << endl;
-            return;
+    void ensureSeries(int id) {
+        if (id < seriesCapacity) return;
+        int newCapacity = seriesCapacity * 2;
+        while (newCapacity <= id) newCapacity *= 2;
+        Series* bigger = new Series[newCapacity];
+        for (int i = 0; i < seriesCapacity; ++i) bigger[i] = series[i];
+        for (int i = seriesCapacity; i < newCapacity; ++i) {
+            bigger[i].first = NULL;
+            bigger[i].more = NULL;
+            bigger[i].chunkCount = 0;
+            bigger[i].moreCapacity = 0;
         }
-        
-        // Simple prediction based on current top rating
-        Team* currentMax = NULL;
-        teamsHT.toArray(allTeamsArray, currentTeamCount); 
-        for (int i = 0; i < currentTeamCount; ++i) {
-            if (!currentMax || allTeamsArray[i].rating > currentMax->rating) {
-                currentMax = &allTeamsArray[i];
+        delete[] series;
+        series = bigger;
+        seriesCapacity = newCapacity;
+    }
+
+    void startChunk(Series& s, int round, int centi) {
+        int capacity = FIRST_CHUNK_BYTES;
+        if (s.chunkCount > 0) {
+            capacity = chunkAt(s, s.chunkCount - 1)->capacity * 2;
+            if (capacity > MAX_CHUNK_BYTES) capacity = MAX_CHUNK_BYTES;
+        }
+        Chunk* c = (Chunk*)allocate((int)offsetof(Chunk, bytes) + capacity);
+        c->startRound = c->lastRound = round;
+        c->startCenti = c->lastCenti = centi;
+        c->used = 0;
+        c->capacity = (unsigned char)capacity;
+
+        if (s.chunkCount == 0) {
+            s.first = c;
+        } else {
+            if (s.chunkCount - 1 == s.moreCapacity) { // Old index is left behind in the arena
+                int newCapacity = s.moreCapacity ? s.moreCapacity * 2 : 2;
+                Chunk** bigger = (Chunk**)allocate(newCapacity * (int)sizeof(Chunk*));
+                for (int i = 0; i < s.chunkCount - 1; ++i) bigger[i] = s.more[i];
+                s.more = bigger;
+                s.moreCapacity = newCapacity;
             }
+            s.more[s.chunkCount - 1] = c;
         }
+        s.chunkCount++;
+        chunkCount++;
+    }
 
-        if (currentMax) {
-            cout << "Prediction based on current max rating: " << currentMax->name << endl;
+public:
+    RatingHistory()
+        : seriesCapacity(16), eventCount(0), chunkCount(0),
+          slabs(NULL), slabCount(0), slabCapacity(0), slabUsed(0), arenaBytes(0) {
+        series = new Series[seriesCapacity];
+        for (int i = 0; i < seriesCapacity; ++i) {
+            series[i].first = NULL;
+            series[i].more = NULL;
+            series[i].chunkCount = 0;
+            series[i].moreCapacity = 0;
         }
-        cout << "================================" << endl;
+    }
+    ~RatingHistory() {
+        clear();
+        if (slabs) delete[] slabs;
+        delete[] series;
+    }
+
+    void clear() {
+        for (int i = 0; i < seriesCapacity; ++i) {
+            series[i].first = NULL;
+            series[i].more = NULL;
+            series[i].chunkCount = 0;
+            series[i].moreCapacity = 0;
+        }
+        for (int i = 0; i < slabCount; ++i) delete[] slabs[i];
+        slabCount = 0;
+        slabUsed = 0;
+        arenaBytes = 0;
+        eventCount = 0;
+        chunkCount = 0;
+    }
+
+    // Record that team `id` has `rating` as of `round`. Rounds never go back.
+    void record(int id, int round, float rating) {
+        if (id < 0) return;
+        ensureSeries(id);
+        Series& s = series[id];
+        int centi = toCenti(rating);
+        eventCount++;
+
+        Chunk* tail = s.chunkCount ? chunkAt(s, s.chunkCount - 1) : NULL;
+        if (!tail || tail->used + MAX_EVENT_BYTES > tail->capacity) {
+            startChunk(s, round, centi); // New checkpoint
+            return;
+        }
+        int delta = centi - tail->lastCenti;
+        int used = tail->used;
+        putVarint(tail->bytes, used, (unsigned int)(round - tail->lastRound));
+        putVarint(tail->bytes, used, ((unsigned int)delta << 1) ^ (unsigned int)(delta >> 31));
+        tail->used = (unsigned char)used;
+        tail->lastRound = round;
+        tail->lastCenti = centi;
+    }
+
+    // Rating of team `id` after `round`. False if it did not exist yet.
+    bool ratingAt(int id, int round, float& rating) const {
+        if (id < 0 || id >= seriesCapacity) return false;
+        const Series& s = series[id];
+        if (s.chunkCount == 0 || s.first->startRound > round) return false;
+
+        // Last checkpoint at or before `round`
+        int lo = 0, hi = s.chunkCount - 1;
+        while (lo < hi) {
+            int mid = (lo + hi + 1) / 2;
+            if (chunkAt(s, mid)->startRound <= round) lo = mid;
+            else hi = mid - 1;
+        }
+        const Chunk* c = chunkAt(s, lo);
+        if (c->lastRound <= round) {
+            rating = c->lastCenti / 100.0f;
+            return true;
+        }
+
+        int atRound = c->startRound;
+        int centi = c->startCenti;
+        int pos = 0;
+        while (pos < c->used) {
+            int gap = (int)getVarint(c->bytes, pos);
+            unsigned int z = getVarint(c->bytes, pos);
+            if (atRound + gap > round) break;
+            atRound += gap;
+            centi += (int)(z >> 1) ^ -(int)(z & 1);
+        }
+        rating = centi / 100.0f;
+        return true;
+    }
+
+    long long events() const { return eventCount; }
+
+    long long bytesUsed() const {
+        return arenaBytes + seriesCapacity * (long long)sizeof(Series);
+    }
+};
+
+
+// Stable bottom-up merge sort. `before(x, y)` is true when x must come
+// before y; ties keep their input order. `scratch` must hold n elements.
+template <typename T, typename Before>
+void stableMergeSort(T* a, T* scratch, long long n, const Before& before) {
+    for (long long width = 1; width < n; width *= 2) {
+        for (long long l = 0; l < n; l += 2 * width) {
+            long long m = (l + width < n) ? l + width : n;
+            long long r = (l + 2 * width < n) ? l + 2 * width : n;
+            long long i = l, j = m, k = l;
+            while (i < m && j < r) scratch[k++] = before(a[j], a[i]) ? a[j++] : a[i++];
+            while (i < m) scratch[k++] = a[i++];
+            while (j < r) scratch[k++] = a[j++];
+        }
+        for (long long i = 0; i < n; ++i) a[i] = scratch[i];
+    }
+}
+
+
+// Compressed (radix) trie over team names for autocomplete and typo-tolerant
+// lookup. Shared prefixes are stored once; children are kept sorted, so
+// prefix results come out in alphabetical order. Nodes live in one array and
+// their labels are slices of one shared byte pool, so splitting an edge only
+// moves offsets around.
+class NameTrie {
+private:
+    struct TrieNode {
+        int labelStart;      // Edge label leading into this node (pool slice)
+        int labelLen;
+        int child;           // First child (sorted by first character), -1 = none
+        int sibling;
+        bool terminal;       // A full team name ends here
+    };
+
+    struct NamePtrBefore {
+        bool operator()(const string* a, const string* b) const { return *a < *b; }
+    };
+
+    TrieNode* nodes;         // nodes[0] is the root
+    int nodeCount;
+    int nodeCapacity;
+    char* pool;
+    int poolSize;
+    int poolCapacity;
+    int nameCount;
+    int longestName;         // Sizes the DP stack for fuzzy search
+
+    void reserve(int moreNodes, int moreBytes) {
+        if (nodeCount + moreNodes > nodeCapacity) {
+            int newCapacity = nodeCapacity * 2;
+            while (newCapacity < nodeCount + moreNodes) newCapacity *= 2;
+            TrieNode* bigger = new TrieNode[newCapacity];
+            for (int i = 0; i < nodeCount; ++i) bigger[i] = nodes[i];
+            delete[] nodes;
+            nodes = bigger;
+            nodeCapacity = newCapacity;
+        }
+        if (poolSize + moreBytes > poolCapacity) {
+            int newCapacity = poolCapacity * 2;
+            while (newCapacity < poolSize + moreBytes) newCapacity *= 2;
+            char* bigger = new char[newCapacity];
+            memcpy(bigger, pool, poolSize);
+            delete[] pool;
+            pool = bigger;
+            poolCapacity = newCapacity;
+        }
+    }
+
+    // New node over an existing pool slice
+    int addSlice(int start, int len) {
+        reserve(1, 0);
+        TrieNode& n = nodes[nodeCount];
+        n.labelStart = start;
+        n.labelLen = len;
+        n.child = n.sibling = -1;
+        n.terminal = false;
+        return nodeCount++;
+    }
+
+    // New node whose label is copied into the pool
+    int addNode(const char* label, int len) {
+        reserve(0, len);
+        memcpy(pool + poolSize, label, len);
+        poolSize += len;
+        return addSlice(poolSize - len, len);
+    }
+
+    // Make `node` the child after `prev` (or the first child) of `parent`
+    void link(int parent, int prev, int node) {
+        if (prev == -1) nodes[parent].child = node;
+        else nodes[prev].sibling = node;
+    }
+
+    unsigned char labelAt(int n, int k) const { return (unsigned char)pool[nodes[n].labelStart + k]; }
+
+    // names[lo, hi) are sorted, unique and share their first `depth`
+    // characters, which is exactly the path spelled out to `parent`
+    void buildRange(int parent, const string** names, int lo, int hi, int depth) {
+        if (lo < hi && (int)names[lo]->size() == depth) {
+            nodes[parent].terminal = true; // Sorted first: it is a prefix of the rest
+            lo++;
+        }
+        int prev = -1;
+        while (lo < hi) {
+            char first = (*names[lo])[depth];
+            int end = lo + 1;
+            while (end < hi && (*names[end])[depth] == first) end++;
+
+            // The group's shared part is the common prefix of its first and last name
+            const string& a = *names[lo];
+            const string& b = *names[end - 1];
+            int common = depth + 1;
+            while (common < (int)a.size() && common < (int)b.size() && a[common] == b[common]) common++;
+
+            int node = addNode(a.data() + depth, common - depth);
+            link(parent, prev, node);
+            prev = node;
+            buildRange(node, names, lo, end, common);
+            lo = end;
+        }
+    }
+
+    // Append every name under `n` (prefix already includes n's label)
+    void collect(int n, string& prefix, string* out, int& found, int limit) const {
+        if (found >= limit) return;
+        if (nodes[n].terminal) out[found++] = prefix;
+        for (int c = nodes[n].child; c != -1 && found < limit; c = nodes[c].sibling) {
+            size_t keep = prefix.size();
+            prefix.append(pool + nodes[c].labelStart, nodes[c].labelLen);
+            collect(c, prefix, out, found, limit);
+            prefix.resize(keep);
+        }
+    }
+
+    // Keep the `limit` closest matches, sorted by distance
+    static void offer(const string& name, int dist, string* out, int* dists, int& found, int limit) {
+        if (found == limit && dists[found - 1] <= dist) return;
+        int i = (found < limit) ? found++ : limit - 1;
+        while (i > 0 && dists[i - 1] > dist) {
+            out[i] = out[i - 1];
+            dists[i] = dists[i - 1];
+            i--;
+        }
+        out[i] = name;
+        dists[i] = dist;
+    }
+
+    // Levenshtein DFS. `dp` is a preallocated stack of DP rows, one per
+    // character of the path: the row for path length L starts at L * (q + 1).
+    void fuzzyWalk(int n, const string& query, int* dp, string& path,
+                   int maxDist, string* out, int* dists, int& found, int limit) const {
+        int q = query.size();
+        int depth = path.size();
+        const TrieNode& node = nodes[n];
+
+        for (int k = 0; k < node.labelLen; ++k) {
+            int* prev = dp + (depth + k) * (q + 1);
+            int* cur = prev + (q + 1);
+            unsigned char ch = labelAt(n, k);
+            cur[0] = prev[0] + 1;
+            int rowMin = cur[0];
+            for (int j = 1; j <= q; ++j) {
+                int cost = ((unsigned char)query[j - 1] == ch) ? 0 : 1;
+                int best = prev[j - 1] + cost;
+                if (prev[j] + 1 < best) best = prev[j] + 1;
+                if (cur[j - 1] + 1 < best) best = cur[j - 1] + 1;
+                cur[j] = best;
+                if (best < rowMin) rowMin = best;
+            }
+            if (rowMin > maxDist) return; // No completion can get back under the bound
+        }
+
+        path.append(pool + node.labelStart, node.labelLen);
+        int dist = dp[path.size() * (q + 1) + q];
+        if (node.terminal && dist <= maxDist) offer(path, dist, out, dists, found, limit);
+        for (int c = node.child; c != -1; c = nodes[c].sibling) {
+            fuzzyWalk(c, query, dp, path, maxDist, out, dists, found, limit);
+        }
+        path.resize(depth);
+    }
+
+public:
+    NameTrie()
+        : nodeCount(0), nodeCapacity(64), poolSize(0), poolCapacity(256), nameCount(0), longestName(0) {
+        nodes = new TrieNode[nodeCapacity];
+        pool = new char[poolCapacity];
+        addSlice(0, 0);
+    }
+    ~NameTrie() {
+        delete[] nodes;
+        delete[] pool;
+    }
+
+    int size() const { return nameCount; }
+
+    void clear() {
+        nodeCount = 0;
+        poolSize = 0;
+        nameCount = 0;
+        longestName = 0;
+        addSlice(0, 0);
+    }
+
+    void insert(const string& name) {
+        if ((int)name.size() > longestName) longestName = name.size();
+        int n = 0;
+        size_t pos = 0;
+        while (true) {
+            if (pos == name.size()) {
+                if (!nodes[n].terminal) nameCount++;
+                nodes[n].terminal = true;
+                return;
+            }
+
+            // Find the child starting with name[pos] (children are sorted)
+            unsigned char want = name[pos];
+            int prev = -1;
+            int c = nodes[n].child;
+            while (c != -1 && labelAt(c, 0) < want) {
+                prev = c;
+                c = nodes[c].sibling;
+            }
+
+            if (c == -1 || labelAt(c, 0) != want) {
+                int leaf = addNode(name.data() + pos, name.size() - pos);
+                nodes[leaf].terminal = true;
+                nodes[leaf].sibling = c;
+                link(n, prev, leaf);
+                nameCount++;
+                return;
+            }
+
+            int common = 0;
+            while (common < nodes[c].labelLen && pos + common < name.size()
+                   && labelAt(c, common) == (unsigned char)name[pos + common]) common++;
+
+            if (common < nodes[c].labelLen) {
+                // Split the edge: c keeps the tail, a new node takes the shared part
+                int mid = addSlice(nodes[c].labelStart, common);
+                nodes[mid].sibling = nodes[c].sibling;
+                nodes[mid].child = c;
+                nodes[c].sibling = -1;
+                nodes[c].labelStart += common;
+                nodes[c].labelLen -= common;
+                link(n, prev, mid);
+                c = mid;
+            }
+            n = c;
+            pos += common;
+        }
+    }
+
+    // Replace the contents with `names` in one pass: sort once, then create
+    // every node exactly once with no searching or edge splits.
+    void build(const string* names, int count) {
+        clear();
+        const string** sorted = new const string*[count > 0 ? count : 1];
+        const string** scratch = new const string*[count > 0 ? count : 1];
+        for (int i = 0; i < count; ++i) sorted[i] = &names[i];
+        stableMergeSort(sorted, scratch, count, NamePtrBefore());
+
+        int unique = 0;
+        int bytes = 0;
+        for (int i = 0; i < count; ++i) {
+            if (unique > 0 && *sorted[unique - 1] == *sorted[i]) continue;
+            sorted[unique++] = sorted[i];
+            bytes += sorted[i]->size();
+            if ((int)sorted[i]->size() > longestName) longestName = sorted[i]->size();
+        }
+        reserve(2 * unique, bytes); // A radix trie has fewer than 2n nodes
+        buildRange(0, sorted, 0, unique, 0);
+        nameCount = unique;
+
+        delete[] sorted;
+        delete[] scratch;
+    }
+
+    // Up to `limit` names starting with `prefix`, alphabetical. Returns count.
+    int prefixSearch(const string& prefix, string* out, int limit) const {
+        int n = 0;
+        size_t pos = 0;
+        string path;
+        while (pos < prefix.size()) {
+            int c = nodes[n].child;
+            while (c != -1 && labelAt(c, 0) != (unsigned char)prefix[pos]) c = nodes[c].sibling;
+            if (c == -1) return 0;
+
+            int k = 0;
+            while (k < nodes[c].labelLen && pos + k < prefix.size()) {
+                if (labelAt(c, k) != (unsigned char)prefix[pos + k]) return 0;
+                k++;
+            }
+            path.append(pool + nodes[c].labelStart, nodes[c].labelLen);
+            pos += k;
+            n = c;
+        }
+        int found = 0;
+        collect(n, path, out, found, limit);
+        return found;
+    }
+
+    // Up to `limit` names within `maxDist` edits of `query`, closest first.
+    int fuzzySearch(const string& query, int maxDist, string* out, int* dists, int limit) const {
+        int q = query.size();
+        int* dp = new int[(longestName + 1) * (q + 1)];
+        for (int j = 0; j <= q; ++j) dp[j] = j;
+
+        int found = 0;
+        string path;
+        path.reserve(longestName);
+        if (nodes[0].terminal && q <= maxDist) offer("", q, out, dists, found, limit);
+        for (int c = nodes[0].child; c != -1; c = nodes[c].sibling) {
+            fuzzyWalk(c, query, dp, path, maxDist, out, dists, found, limit);
+        }
+        delete[] dp;
+        return found;
+    }
+};
+
+
+// Reusable barrier for a fixed set of threads (generation counting)
+class PhaseBarrier {
+private:
+    mutex m;
+    condition_variable cv;
+    int parties;
+    int waiting;
+    long long generation;
+
+public:
+    PhaseBarrier(int n) : parties(n), waiting(0), generation(0) {}
+
+    void arriveAndWait() {
+        unique_lock<mutex> lock(m);
+        long long gen = generation;
+        if (++waiting == parties) {
+            waiting = 0;
+            generation++;
+            cv.notify_all();
+            return;
+        }
+        while (gen == generation) cv.wait(lock);
+    }
+};
+
+
+// PageRank-style power ranking over the defeat graph. Beating a team that
+// has itself beaten strong teams is worth more, so strength of schedule is
+// built in. The ranker keeps its own CSR copy of the graph current from
+// Graph's change log (rows have slack and move to the end when they fill
+// up), keeps a persistent set of worker threads that meet at a barrier
+// every iteration, and warm-starts from the last solution.
+class PowerRanker {
+private:
+    double* scores;
+    int scoredCount;
+    int threadCount;
+    double damping;
+    double tolerance;
+    int maxIterations;
+
+    // Incremental CSR: row w lists the teams w has beaten
+    int rows, rowCapacity;
+    int* rowStart;
+    int* rowLen;
+    int* rowCap;
+    int* cols;
+    int* weights;    // Head-to-head wins
+    int edgeEnd, edgeCapacity, garbage;
+    int* lossTotal;  // Total losses per team (out-weight of the loser)
+
+    // Per-iteration job, read by every worker between the two barriers
+    const double* current;
+    double* next;
+    double teleport;
+    int jobRows;
+    double* partialDelta;
+    double* partialDangling;
+
+    thread* workers;
+    int workerCount;
+    PhaseBarrier* barrier;
+    bool stopping;
+
+    void ensureRows(int n) {
+        if (n > rowCapacity) {
+            int newCapacity = rowCapacity ? rowCapacity * 2 : 64;
+            while (newCapacity < n) newCapacity *= 2;
+            int* s = new int[newCapacity];
+            int* l = new int[newCapacity];
+            int* c = new int[newCapacity];
+            int* t = new int[newCapacity];
+            for (int i = 0; i < rows; ++i) {
+                s[i] = rowStart[i];
+                l[i] = rowLen[i];
+                c[i] = rowCap[i];
+                t[i] = lossTotal[i];
+            }
+            if (rowStart) {
+                delete[] rowStart;
+                delete[] rowLen;
+                delete[] rowCap;
+                delete[] lossTotal;
+            }
+            rowStart = s;
+            rowLen = l;
+            rowCap = c;
+            lossTotal = t;
+            rowCapacity = newCapacity;
+        }
+        for (int i = rows; i < n; ++i) {
+            rowStart[i] = edgeEnd;
+            rowLen[i] = rowCap[i] = 0;
+            lossTotal[i] = 0;
+        }
+        if (n > rows) rows = n;
+    }
+
+    void ensureEdges(int needed) {
+        if (needed <= edgeCapacity) return;
+        int newCapacity = edgeCapacity ? edgeCapacity * 2 : 256;
+        while (newCapacity < needed) newCapacity *= 2;
+        int* c = new int[newCapacity];
+        int* w = new int[newCapacity];
+        for (int i = 0; i < edgeEnd; ++i) {
+            c[i] = cols[i];
+            w[i] = weights[i];
+        }
+        if (cols) {
+            delete[] cols;
+            delete[] weights;
+        }
+        cols = c;
+        weights = w;
+        edgeCapacity = newCapacity;
+    }
+
+    // Drop the holes left behind by relocated rows
+    void compact() {
+        int* c = new int[edgeCapacity];
+        int* w = new int[edgeCapacity];
+        int pos = 0;
+        for (int r = 0; r < rows; ++r) {
+            for (int k = 0; k < rowLen[r]; ++k) {
+                c[pos + k] = cols[rowStart[r] + k];
+                w[pos + k] = weights[rowStart[r] + k];
+            }
+            rowStart[r] = pos;
+            pos += rowCap[r];
+        }
+        delete[] cols;
+        delete[] weights;
+        cols = c;
+        weights = w;
+        edgeEnd = pos;
+        garbage = 0;
+    }
+
+    void applyChange(int w, int l, int delta) {
+        ensureRows((w > l ? w : l) + 1);
+        lossTotal[l] += delta;
+        for (int e = rowStart[w]; e < rowStart[w] + rowLen[w]; ++e) {
+            if (cols[e] != l) continue;
+            weights[e] += delta;
+            if (weights[e] <= 0) { // Edge gone: move the row's last edge here
+                int last = rowStart[w] + --rowLen[w];
+                cols[e] = cols[last];
+                weights[e] = weights[last];
+            }
+            return;
+        }
+        if (delta <= 0) return;
+
+        if (rowLen[w] == rowCap[w]) { // Row full: move it to the end with room to grow
+            int newCap = rowCap[w] ? rowCap[w] * 2 : 4;
+            ensureEdges(edgeEnd + newCap);
+            for (int k = 0; k < rowLen[w]; ++k) {
+                cols[edgeEnd + k] = cols[rowStart[w] + k];
+                weights[edgeEnd + k] = weights[rowStart[w] + k];
+            }
+            garbage += rowCap[w];
+            rowStart[w] = edgeEnd;
+            rowCap[w] = newCap;
+            edgeEnd += newCap;
+        }
+        int e = rowStart[w] + rowLen[w]++;
+        cols[e] = l;
+        weights[e] = delta;
+
+        if (garbage > edgeEnd / 2) compact();
+    }
+
+    // Cold copy of the whole graph, when its change log does not cover
+    // everything since the last sync (first use, or the log overflowed)
+    void rebuild(const Graph& g) {
+        int* rs;
+        int* c;
+        float* w;
+        g.buildCSR(rs, c, w);
+        int n = g.size();
+        rows = 0;
+        edgeEnd = 0;
+        garbage = 0;
+        ensureRows(n);
+        ensureEdges(rs[n]);
+        for (int r = 0; r < n; ++r) {
+            rowStart[r] = rs[r];
+            rowLen[r] = rowCap[r] = rs[r + 1] - rs[r];
+        }
+        for (int e = 0; e < rs[n]; ++e) {
+            cols[e] = c[e];
+            weights[e] = (int)w[e];
+            lossTotal[c[e]] += weights[e];
+        }
+        edgeEnd = rs[n];
+        delete[] rs;
+        delete[] c;
+        delete[] w;
+    }
+
+    // Apply every head-to-head change since the last call
+    void syncWith(Graph& g) {
+        if (!g.changesTracked()) {
+            rebuild(g);
+        } else {
+            for (int i = 0; i < g.pendingChanges(); ++i) {
+                const Graph::EdgeChange& c = g.changeAt(i);
+                applyChange(c.winner, c.loser, c.delta);
+            }
+        }
+        g.trackChanges();
+        ensureRows(g.size());
+    }
+
+    void iterateSlice(int slot) {
+        int parties = workerCount + 1;
+        int chunk = (jobRows + parties - 1) / parties;
+        int from = slot * chunk;
+        int to = (from + chunk < jobRows) ? from + chunk : jobRows;
+
+        double delta = 0, dangling = 0;
+        for (int w = from; w < to; ++w) {
+            // Every loss "votes" for the winner, split across the loser's defeats
+            double inflow = 0;
+            for (int e = rowStart[w]; e < rowStart[w] + rowLen[w]; ++e) {
+                int l = cols[e];
+                inflow += current[l] * weights[e] / lossTotal[l];
+            }
+            double value = teleport + damping * inflow;
+            next[w] = value;
+            delta += (value > current[w]) ? value - current[w] : current[w] - value;
+            if (lossTotal[w] == 0) dangling += value;
+        }
+        partialDelta[slot] = delta;
+        partialDangling[slot] = dangling;
+    }
+
+    // Helpers wait at the barrier, run their slice, and meet again
+    void workerLoop(int slot) {
+        while (true) {
+            barrier->arriveAndWait();
+            if (stopping) return;
+            iterateSlice(slot);
+            barrier->arriveAndWait();
+        }
+    }
+
+    void startWorkers() {
+        if (barrier) return;
+        workerCount = threadCount - 1; // The calling thread is slot 0
+        partialDelta = new double[workerCount + 1];
+        partialDangling = new double[workerCount + 1];
+        barrier = new PhaseBarrier(workerCount + 1);
+        workers = new thread[workerCount > 0 ? workerCount : 1];
+        for (int t = 0; t < workerCount; ++t) workers[t] = thread(&PowerRanker::workerLoop, this, t + 1);
+    }
+
+public:
+    PowerRanker(int threads = 0)
+        : scores(NULL), scoredCount(0), damping(0.85), tolerance(1e-9), maxIterations(200),
+          rows(0), rowCapacity(0), rowStart(NULL), rowLen(NULL), rowCap(NULL), cols(NULL), weights(NULL),
+          edgeEnd(0), edgeCapacity(0), garbage(0), lossTotal(NULL), current(NULL), next(NULL),
+          teleport(0), jobRows(0), partialDelta(NULL), partialDangling(NULL),
+          workers(NULL), workerCount(0), barrier(NULL), stopping(false) {
+        threadCount = threads > 0 ? threads : (int)thread::hardware_concurrency();
+        if (threadCount < 1) threadCount = 1;
+    }
+    ~PowerRanker() {
+        if (barrier) {
+            stopping = true;
+            barrier->arriveAndWait();
+            for (int t = 0; t < workerCount; ++t) workers[t].join();
+            delete[] workers;
+            delete barrier;
+            delete[] partialDelta;
+            delete[] partialDangling;
+        }
+        if (scores) delete[] scores;
+        if (rowStart) {
+            delete[] rowStart;
+            delete[] rowLen;
+            delete[] rowCap;
+            delete[] lossTotal;
+        }
+        if (cols) {
+            delete[] cols;
+            delete[] weights;
+        }
+    }
+
+    bool hasSolution() const { return scoredCount > 0; }
+    int solvedCount() const { return scoredCount; }
+    double scoreOf(int idx) const { return (idx >= 0 && idx < scoredCount) ? scores[idx] : 0; }
+
+    // Returns the number of iterations needed to converge.
+    int rank(Graph& g, bool warmStart = true) {
+        syncWith(g);
+        int n = g.size();
+        if (n == 0) return 0;
+        startWorkers();
+
+        // Warm start: reuse the previous scores, new teams start at 1/n
+        double* cur = new double[n];
+        double* nxt = new double[n];
+        int reused = warmStart ? (scoredCount < n ? scoredCount : n) : 0;
+        double sum = 0;
+        for (int i = 0; i < n; ++i) {
+            cur[i] = (i < reused) ? scores[i] : 1.0 / n;
+            sum += cur[i];
+        }
+        for (int i = 0; i < n; ++i) cur[i] /= sum;
+
+        double dangling = 0;
+        for (int i = 0; i < n; ++i) if (lossTotal[i] == 0) dangling += cur[i];
+
+        jobRows = n;
+        int iterations = 0;
+        while (iterations < maxIterations) {
+            current = cur;
+            next = nxt;
+            teleport = (1 - damping) / n + damping * dangling / n;
+
+            barrier->arriveAndWait(); // Release the helpers
+            iterateSlice(0);
+            barrier->arriveAndWait(); // Wait for every slice
+
+            double delta = 0;
+            dangling = 0;
+            for (int t = 0; t <= workerCount; ++t) {
+                delta += partialDelta[t];
+                dangling += partialDangling[t];
+            }
+
+            double* tmp = cur;
+            cur = nxt;
+            nxt = tmp;
+            iterations++;
+            if (delta < tolerance) break; // Converged (L1 change)
+        }
+
+        if (scores) delete[] scores;
+        scores = cur;
+        scoredCount = n;
+        delete[] nxt;
+        return iterations;
+    }
+
+    void showTop(const Graph& g, int limit) const {
+        int n = scoredCount < g.size() ? scoredCount : g.size();
+        int* order = new int[n];
+        for (int i = 0; i < n; ++i) order[i] = i;
+        // Partial selection sort: only the top `limit` are needed
+        int shown = limit < n ? limit : n;
+        for (int i = 0; i < shown; ++i) {
+            int best = i;
+            for (int j = i + 1; j < n; ++j)
+                if (scores[order[j]] > scores[order[best]]) best = j;
+            swap(order[i], order[best]);
+            cout << i + 1 << ". " << g.nameAt(order[i])
+                 << " | Power: " << scores[order[i]] * n << endl;
+        }
+        delete[] order;
+    }
+};
+
+
+class TournamentTree {
+public:
+    struct TNode {
+        string teamName;
+        TNode* left;
+        TNode* right;
+        TNode(string n) : teamName(n), left(NULL), right(NULL) {}
+    };
+    TNode* root;
+
+    TournamentTree() : root(NULL) {}
+
+    void printInorder(TNode* r) {
+        if (!r) return;
+        printInorder(r->left);
+        cout << r->teamName << " ";
+        printInorder(r->right);
+    }
+};
+
+
+void merge(Team arr[], int l, int m, int r) {
+    int i, j, k;
+    int n1 = m - l + 1;
+    int n2 = r - m;
+
+    Team* L = new Team[n1];
+    Team* R = new Team[n2];
+
+    for (i = 0; i < n1; i++) L[i] = arr[l + i];
+    for (j = 0; j < n2; j++) R[j] = arr[m + 1 + j];
+
+    i = 0; j = 0; k = l;
+    while (i < n1 && j < n2) {
+        if (L[i].rating >= R[j].rating) { 
+            arr[k] = L[i];
+            i++;
+        } else {
+            arr[k] = R[j];
+            j++;
+        }
+        k++;
+    }
+
+    while (i < n1) { arr[k] = L[i]; i++; k++; }
+    while (j < n2) { arr[k] = R[j]; j++; k++; }
+    
+    delete[] L;
+    delete[] R;
+}
+
+void mergeSort(Team arr[], int l, int r) {
+    if (l < r) {
+        int m = l + (r - l) / 2;
+        mergeSort(arr, l, m);
+        mergeSort(arr, m + 1, r);
+        merge(arr, l, m, r);
+    }
+}
+
+
+// Fixed-size team record for the out-of-core (external-memory) mode
+struct DiskTeam {
+    char name[48]; // Truncated, always NUL-terminated
+    float rating;
+    int wins;
+    int losses;
+};
+
+DiskTeam makeDiskTeam(const string& name, float rating, int wins, int losses) {
+    DiskTeam d;
+    memset(d.name, 0, sizeof(d.name));
+    strncpy(d.name, name.c_str(), sizeof(d.name) - 1);
+    d.rating = rating;
+    d.wins = wins;
+    d.losses = losses;
+    return d;
+}
+
+
+// Page id -> frame for a buffer pool. Open addressing, kept at most half
+// full of the pool's frames, so its size is bounded by the pool rather
+// than by the length of the file.
+class PageTable {
+private:
+    struct Slot {
+        long long pageId; // -1 when empty
+        int frame;
+    };
+
+    Slot* slots;
+    int mask;
+
+    int home(long long pageId) const {
+        return (int)(((unsigned long long)pageId * 0x9E3779B97F4A7C15ULL) >> 40) & mask;
+    }
+
+    static int capacityFor(int frames) {
+        int capacity = 4;
+        while (capacity < 2 * frames) capacity *= 2;
+        return capacity;
+    }
+
+public:
+    PageTable(int frames) {
+        int capacity = capacityFor(frames);
+        slots = new Slot[capacity];
+        mask = capacity - 1;
+        for (int i = 0; i < capacity; ++i) slots[i].pageId = -1;
+    }
+    ~PageTable() { delete[] slots; }
+
+    static long long bytesFor(int frames) { return (long long)capacityFor(frames) * sizeof(Slot); }
+
+    // Frame holding `pageId`, or -1 when it is not resident
+    int get(long long pageId) const {
+        for (int i = home(pageId); slots[i].pageId != -1; i = (i + 1) & mask) {
+            if (slots[i].pageId == pageId) return slots[i].frame;
+        }
+        return -1;
+    }
+
+    void put(long long pageId, int frame) {
+        int i = home(pageId);
+        while (slots[i].pageId != -1 && slots[i].pageId != pageId) i = (i + 1) & mask;
+        slots[i].pageId = pageId;
+        slots[i].frame = frame;
+    }
+
+    // Backward-shift deletion keeps every probe chain unbroken
+    void remove(long long pageId) {
+        int i = home(pageId);
+        while (slots[i].pageId != pageId) {
+            if (slots[i].pageId == -1) return;
+            i = (i + 1) & mask;
+        }
+        int j = i;
+        while (true) {
+            j = (j + 1) & mask;
+            if (slots[j].pageId == -1) break;
+            int k = home(slots[j].pageId);
+            bool stays = (i <= j) ? (i < k && k <= j) : (i < k || k <= j);
+            if (stays) continue;
+            slots[i] = slots[j];
+            i = j;
+        }
+        slots[i].pageId = -1;
+    }
+};
+
+
+// Fixed set of page frames with clock (second-chance) eviction. Resident
+// pages are found through a PageTable, so the pool's memory depends only on
+// the frame count, never on the file size. The owner does the page I/O.
+class ClockFramePool {
+public:
+    static const int PAGE_BYTES = 4096;
+
+    struct Frame {
+        long long pageId; // -1 when free
+        bool dirty;       // Only used by owners that write pages back
+        bool referenced;
+        alignas(8) char bytes[PAGE_BYTES];
+    };
+
+private:
+    Frame* frames;
+    int frameCount;
+    int clockHand;
+    PageTable* frameOfPage;
+
+public:
+    long long hits, misses, evictions;
+
+    ClockFramePool(int count)
+        : frameCount(count < 2 ? 2 : count), clockHand(0), hits(0), misses(0), evictions(0) {
+        frames = new Frame[frameCount];
+        for (int i = 0; i < frameCount; ++i) {
+            frames[i].pageId = -1;
+            frames[i].dirty = false;
+            frames[i].referenced = false;
+        }
+        frameOfPage = new PageTable(frameCount);
+    }
+    ~ClockFramePool() {
+        delete[] frames;
+        delete frameOfPage;
+    }
+
+    // Most frames whose pool (page table included) fits in `poolBytes`
+    static int framesFor(long long poolBytes) {
+        int count = (int)(poolBytes / sizeof(Frame));
+        while (count > 2 && count * (long long)sizeof(Frame) + PageTable::bytesFor(count) > poolBytes)
+            count--;
+        return count < 2 ? 2 : count;
+    }
+
+    int size() const { return frameCount; }
+    long long bytes() const { return (long long)frameCount * sizeof(Frame) + PageTable::bytesFor(frameCount); }
+    Frame& frame(int i) { return frames[i]; }
+
+    // Resident frame holding `pageId`, or NULL
+    Frame* lookup(long long pageId) {
+        int slot = frameOfPage->get(pageId);
+        if (slot == -1) return NULL;
+        hits++;
+        frames[slot].referenced = true;
+        return &frames[slot];
+    }
+
+    // Map `pageId` to the frame the clock picks. The frame still holds the
+    // evicted page (its id goes to `evicted`, -1 if the frame was free) so
+    // the owner can write it back before loading the new one.
+    Frame& claim(long long pageId, long long& evicted) {
+        misses++;
+        while (frames[clockHand].pageId != -1 && frames[clockHand].referenced) {
+            frames[clockHand].referenced = false;
+            clockHand = (clockHand + 1) % frameCount;
+        }
+        Frame& victim = frames[clockHand];
+        evicted = victim.pageId;
+        if (evicted != -1) {
+            frameOfPage->remove(evicted);
+            evictions++;
+        }
+        victim.pageId = pageId;
+        victim.referenced = true;
+        frameOfPage->put(pageId, clockHand);
+        clockHand = (clockHand + 1) % frameCount;
+        return victim;
+    }
+};
+
+
+// Disk-backed team store for fields larger than RAM. Records live in
+// fixed-size pages in a file; only the pool's frames are ever held in
+// memory, and dirty pages are written back on eviction.
+class PagedTeamStore {
+public:
+    static const int PAGE_BYTES = ClockFramePool::PAGE_BYTES;
+    static const int PER_PAGE = PAGE_BYTES / sizeof(DiskTeam);
+
+private:
+    typedef ClockFramePool::Frame Frame;
+
+    fstream file;
+    ClockFramePool pool;
+    long long recordCount;
+
+    static DiskTeam* records(Frame& f) { return (DiskTeam*)f.bytes; }
+
+    void writeBack(Frame& f, long long pageId) {
+        file.seekp(pageId * PAGE_BYTES);
+        file.write(f.bytes, PER_PAGE * sizeof(DiskTeam));
+        f.dirty = false;
+    }
+
+    Frame& pin(long long pageId, bool fresh) {
+        Frame* hit = pool.lookup(pageId);
+        if (hit) return *hit;
+
+        long long evicted;
+        Frame& f = pool.claim(pageId, evicted);
+        if (evicted != -1 && f.dirty) writeBack(f, evicted);
+        f.dirty = false;
+        if (fresh) {
+            memset(f.bytes, 0, PAGE_BYTES);
+        } else {
+            file.clear();
+            file.seekg(pageId * PAGE_BYTES);
+            file.read(f.bytes, PER_PAGE * sizeof(DiskTeam));
+            file.clear(); // A short final page is fine
+        }
+        return f;
+    }
+
+public:
+    PagedTeamStore(const string& path, long long poolBytes)
+        : pool(ClockFramePool::framesFor(poolBytes)), recordCount(0) {
+        file.open(path.c_str(), ios::in | ios::out | ios::binary | ios::trunc);
+    }
+    ~PagedTeamStore() { flush(); }
+
+    bool ok() const { return file.is_open(); }
+    long long size() const { return recordCount; }
+    long long poolBytes() const { return pool.bytes(); }
+    long long hits() const { return pool.hits; }
+    long long misses() const { return pool.misses; }
+    long long evictions() const { return pool.evictions; }
+
+    void append(const DiskTeam& d) {
+        long long pageId = recordCount / PER_PAGE;
+        Frame& f = pin(pageId, recordCount % PER_PAGE == 0);
+        records(f)[recordCount % PER_PAGE] = d;
+        f.dirty = true;
+        recordCount++;
+    }
+
+    DiskTeam get(long long i) {
+        return records(pin(i / PER_PAGE, false))[i % PER_PAGE];
+    }
+
+    void put(long long i, const DiskTeam& d) {
+        Frame& f = pin(i / PER_PAGE, false);
+        records(f)[i % PER_PAGE] = d;
+        f.dirty = true;
+    }
+
+    void flush() {
+        for (int i = 0; i < pool.size(); ++i) {
+            Frame& f = pool.frame(i);
+            if (f.pageId != -1 && f.dirty) writeBack(f, f.pageId);
+        }
+        file.flush();
+    }
+};
+
+
+struct DiskTeamBefore {
+    bool operator()(const DiskTeam& x, const DiskTeam& y) const { return x.rating > y.rating; }
+};
+
+// Stable sort on records, highest rating first (same order as mergeSort)
+void sortDiskTeams(DiskTeam* a, DiskTeam* scratch, long long n) {
+    stableMergeSort(a, scratch, n, DiskTeamBefore());
+}
+
+
+// Buffered sequential reader over a sorted run file
+struct RunReader {
+    ifstream in;
+    DiskTeam* buffer;
+    long long capacity, filled, pos;
+
+    bool refill() {
+        in.read((char*)buffer, capacity * sizeof(DiskTeam));
+        filled = in.gcount() / sizeof(DiskTeam);
+        pos = 0;
+        return filled > 0;
+    }
+    bool hasNext() { return pos < filled || refill(); }
+    const DiskTeam& peek() const { return buffer[pos]; }
+};
+
+
+// External merge sort: sorted runs no larger than the memory budget are
+// spilled to disk, then merged (max-heap over run heads) with bounded
+// fan-in, in as many passes as needed. Output goes to `outPath`.
+class ExternalSorter {
+private:
+    long long budgetRecords;
+    int runCounter;
+
+    string runName(int id) const { return "extsort_run_" + to_string(id) + ".tmp"; }
+
+    void siftDown(int* heap, int size, RunReader* readers, int i) {
+        while (true) {
+            int best = i, l = 2 * i + 1, r = 2 * i + 2;
+            if (l < size && readers[heap[l]].peek().rating > readers[heap[best]].peek().rating) best = l;
+            if (r < size && readers[heap[r]].peek().rating > readers[heap[best]].peek().rating) best = r;
+            if (best == i) return;
+            swap(heap[i], heap[best]);
+            i = best;
+        }
+    }
+
+    // Merge runs [from, from + count) of `runs` into `outPath`
+    void mergeRuns(const int* runs, int count, const string& outPath) {
+        long long perReader = budgetRecords / (count + 1);
+        RunReader* readers = new RunReader[count];
+        int* heap = new int[count];
+        int heapSize = 0;
+        for (int i = 0; i < count; ++i) {
+            readers[i].in.open(runName(runs[i]).c_str(), ios::binary);
+            readers[i].capacity = perReader;
+            readers[i].buffer = new DiskTeam[perReader];
+            readers[i].filled = readers[i].pos = 0;
+            if (readers[i].hasNext()) heap[heapSize++] = i;
+        }
+        for (int i = heapSize / 2 - 1; i >= 0; --i) siftDown(heap, heapSize, readers, i);
+
+        ofstream out(outPath.c_str(), ios::binary | ios::trunc);
+        DiskTeam* outBuf = new DiskTeam[perReader];
+        long long outFilled = 0;
+        while (heapSize > 0) {
+            RunReader& top = readers[heap[0]];
+            outBuf[outFilled++] = top.peek();
+            if (outFilled == perReader) {
+                out.write((const char*)outBuf, outFilled * sizeof(DiskTeam));
+                outFilled = 0;
+            }
+            top.pos++;
+            if (!top.hasNext()) heap[0] = heap[--heapSize];
+            siftDown(heap, heapSize, readers, 0);
+        }
+        out.write((const char*)outBuf, outFilled * sizeof(DiskTeam));
+
+        for (int i = 0; i < count; ++i) {
+            readers[i].in.close();
+            delete[] readers[i].buffer;
+            remove(runName(runs[i]).c_str());
+        }
+        delete[] outBuf;
+        delete[] heap;
+        delete[] readers;
+    }
+
+public:
+    int runsWritten, mergePasses;
+
+    long long memoryBytes() const { return budgetRecords * (long long)sizeof(DiskTeam); }
+
+    ExternalSorter(long long memoryBytes) : runCounter(0), runsWritten(0), mergePasses(0) {
+        budgetRecords = memoryBytes / sizeof(DiskTeam);
+        long long minimum = 3 * PagedTeamStore::PER_PAGE;
+        if (budgetRecords < minimum) budgetRecords = minimum;
+    }
+
+    void sort(PagedTeamStore& store, const string& outPath) {
+        // Pass 0: sorted runs (half the budget for data, half for scratch)
+        long long runRecords = budgetRecords / 2;
+        DiskTeam* run = new DiskTeam[runRecords];
+        DiskTeam* scratch = new DiskTeam[runRecords];
+
+        long long total = store.size();
+        int runCount = (int)((total + runRecords - 1) / runRecords);
+        int* runs = new int[runCount > 0 ? runCount : 1];
+        for (int r = 0; r < runCount; ++r) {
+            long long from = r * runRecords;
+            long long n = (from + runRecords < total) ? runRecords : total - from;
+            for (long long i = 0; i < n; ++i) run[i] = store.get(from + i);
+            sortDiskTeams(run, scratch, n);
+
+            runs[r] = runCounter++;
+            ofstream out(runName(runs[r]).c_str(), ios::binary | ios::trunc);
+            out.write((const char*)run, n * sizeof(DiskTeam));
+            runsWritten++;
+        }
+        delete[] run;
+        delete[] scratch;
+
+        // Merge passes with fan-in limited by the budget (>= 1 page per reader)
+        int fanIn = (int)(budgetRecords / PagedTeamStore::PER_PAGE) - 1;
+        if (fanIn < 2) fanIn = 2;
+        while (runCount > 1) {
+            int merged = 0;
+            for (int i = 0; i < runCount; i += fanIn) {
+                int count = (i + fanIn < runCount) ? fanIn : runCount - i;
+                int id = runCounter++;
+                mergeRuns(runs + i, count, runName(id));
+                runs[merged++] = id;
+            }
+            runCount = merged;
+            mergePasses++;
+        }
+
+        remove(outPath.c_str());
+        if (runCount == 1) rename(runName(runs[0]).c_str(), outPath.c_str());
+        else ofstream(outPath.c_str(), ios::binary | ios::trunc); // Empty field
+        delete[] runs;
+    }
+};
+
+
+// Peak resident set size of this process in MB
+double peakRssMB() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0; // Linux reports KB
+}
+
+// Current resident set size in MB (0 if /proc is unavailable)
+double currentRssMB() {
+    ifstream status("/proc/self/status");
+    string key;
+    while (status >> key) {
+        if (key == "VmRSS:") {
+            double kb = 0;
+            status >> kb;
+            return kb / 1024.0;
+        }
+        status.ignore(1000, '\n');
+    }
+    return 0;
+}
+
+
+// On-disk layout of teams.db, the indexed save used for lazy startup:
+// header | index (sorted by name) | records | adjacency | losses | leaderboard | results | names
+// Names are stored in full in the names blob; index entries and records
+// point into it. Every defeat is stored twice, under the winner (adjacency)
+// and under the loser (losses), so one team's record reads only its own lists.
+struct DbHeader {
+    char magic[8];
+    int teamCount;
+    int round;
+    int resultCount;
+    int edgeCount;
+    long long indexOffset;
+    long long recordOffset;
+    long long adjacencyOffset;
+    long long lossesOffset;
+    long long leaderboardOffset; // Record ids, highest rating first
+    long long resultsOffset;
+    long long namesOffset;
+    long long textBytes; // Size of the teams.txt written with it
+};
+
+struct DbIndexEntry {
+    long long nameOffset;
+    int nameLength;
+    int recordId;
+};
+
+struct DbRecord {
+    float rating;
+    int wins;
+    int losses;
+    int nameLength;
+    long long nameOffset;
+    long long adjOffset;  // First DbEdge of this team's defeats
+    long long lossOffset; // First DbEdge of the teams that beat this one
+    int adjCount;
+    int lossCount;
+};
+
+struct DbEdge {
+    int other; // Record id of the opponent
+    int wins;  // Head-to-head wins of the winner over the loser
+};
+
+struct DbResult {
+    int winner;
+    int loser; // -1 for a bye
+};
+
+const char DB_MAGIC[8] = { 'T', 'M', 'S', 'D', 'B', '3', 0, 0 };
+
+
+// Read-only page cache over a file: a ClockFramePool whose pages are
+// loaded on demand. Any byte range can be read through it.
+class PageCache {
+public:
+    static const int PAGE_BYTES = ClockFramePool::PAGE_BYTES;
+
+private:
+    typedef ClockFramePool::Frame Frame;
+
+    ifstream file;
+    ClockFramePool pool;
+    long long fileBytes;
+    long long pageCount;
+
+    Frame& pin(long long pageId) {
+        Frame* hit = pool.lookup(pageId);
+        if (hit) return *hit;
+
+        long long evicted;
+        Frame& f = pool.claim(pageId, evicted);
+        file.clear();
+        file.seekg(pageId * PAGE_BYTES);
+        file.read(f.bytes, PAGE_BYTES);
+        file.clear(); // Last page may be short
+        return f;
+    }
+
+public:
+    PageCache(int frames) : pool(frames), fileBytes(0), pageCount(0) {}
+
+    long long hits() const { return pool.hits; }
+    long long misses() const { return pool.misses; }
+
+    bool open(const string& path) {
+        file.open(path.c_str(), ios::binary);
+        if (!file.is_open()) return false;
+        file.seekg(0, ios::end);
+        fileBytes = file.tellg();
+        pageCount = (fileBytes + PAGE_BYTES - 1) / PAGE_BYTES;
+        return true;
+    }
+
+    long long size() const { return fileBytes; }
+
+    void read(long long offset, void* out, long long len) {
+        char* dst = (char*)out;
+        while (len > 0) {
+            long long pageId = offset / PAGE_BYTES;
+            int within = (int)(offset % PAGE_BYTES);
+            int chunk = PAGE_BYTES - within;
+            if (chunk > len) chunk = (int)len;
+            if (pageId >= pageCount) {
+                memset(dst, 0, len);
+                return;
+            }
+            memcpy(dst, pin(pageId).bytes + within, chunk);
+            dst += chunk;
+            offset += chunk;
+            len -= chunk;
+        }
+    }
+};
+
+
+// Lazy view of teams.db. Opening reads only the header; everything else is
+// fetched through the page cache on first use.
+class LazyTeamStore {
+private:
+    PageCache cache;
+
+public:
+    DbHeader header;
+
+    LazyTeamStore(int cacheFrames = 256) : cache(cacheFrames) {}
+
+    bool open(const string& path) {
+        if (!cache.open(path) || cache.size() < (long long)sizeof(DbHeader)) return false;
+        cache.read(0, &header, sizeof(DbHeader));
+        return memcmp(header.magic, DB_MAGIC, sizeof(DB_MAGIC)) == 0;
+    }
+
+    // Sections are written back to back in a fixed order, so each offset
+    // must be exactly where the counts before it put it, and the names
+    // blob must start inside the file
+    bool layoutValid() const {
+        const DbHeader& h = header;
+        if (h.teamCount < 0 || h.resultCount < 0 || h.edgeCount < 0 || h.round < 0) return false;
+        long long at = sizeof(DbHeader);
+        if (h.indexOffset != at) return false;
+        at += (long long)h.teamCount * sizeof(DbIndexEntry);
+        if (h.recordOffset != at) return false;
+        at += (long long)h.teamCount * sizeof(DbRecord);
+        if (h.adjacencyOffset != at) return false;
+        at += (long long)h.edgeCount * sizeof(DbEdge);
+        if (h.lossesOffset != at) return false;
+        at += (long long)h.edgeCount * sizeof(DbEdge);
+        if (h.leaderboardOffset != at) return false;
+        at += (long long)h.teamCount * sizeof(int);
+        if (h.resultsOffset != at) return false;
+        at += (long long)h.resultCount * sizeof(DbResult);
+        return h.namesOffset == at && at <= cache.size();
+    }
+
+    long long cacheHits() const { return cache.hits(); }
+    long long cacheMisses() const { return cache.misses(); }
+
+    string readName(long long offset, int length) {
+        if (length < 0 || offset < header.namesOffset || offset + length > cache.size()) return "";
+        string s(length, '\0');
+        if (length > 0) cache.read(offset, &s[0], length);
+        return s;
+    }
+
+    string nameOf(const DbRecord& r) { return readName(r.nameOffset, r.nameLength); }
+    string nameOf(int id) { return nameOf(record(id)); }
+
+    // Binary search over the on-disk name index. -1 if absent.
+    int findRecord(const string& name) {
+        int lo = 0, hi = header.teamCount - 1;
+        DbIndexEntry e;
+        while (lo <= hi) {
+            int mid = lo + (hi - lo) / 2;
+            cache.read(header.indexOffset + (long long)mid * sizeof(DbIndexEntry), &e, sizeof(e));
+            int cmp = name.compare(readName(e.nameOffset, e.nameLength));
+            if (cmp == 0) return e.recordId;
+            if (cmp < 0) hi = mid - 1;
+            else lo = mid + 1;
+        }
+        return -1;
+    }
+
+    DbRecord record(int id) {
+        DbRecord r;
+        cache.read(header.recordOffset + (long long)id * sizeof(DbRecord), &r, sizeof(r));
+        return r;
+    }
+
+    DbEdge edge(const DbRecord& r, int k) {
+        DbEdge e;
+        cache.read(r.adjOffset + (long long)k * sizeof(DbEdge), &e, sizeof(e));
+        return e;
+    }
+
+    DbEdge loss(const DbRecord& r, int k) {
+        DbEdge e;
+        cache.read(r.lossOffset + (long long)k * sizeof(DbEdge), &e, sizeof(e));
+        return e;
+    }
+
+    // Up to `limit` names starting with `prefix`, in index (byte) order
+    int prefixSearch(const string& prefix, string* out, int limit) {
+        int lo = 0, hi = header.teamCount; // First entry not below the prefix
+        DbIndexEntry e;
+        while (lo < hi) {
+            int mid = lo + (hi - lo) / 2;
+            cache.read(header.indexOffset + (long long)mid * sizeof(DbIndexEntry), &e, sizeof(e));
+            if (readName(e.nameOffset, e.nameLength) < prefix) lo = mid + 1;
+            else hi = mid;
+        }
+        int found = 0;
+        for (int i = lo; i < header.teamCount && found < limit; ++i) {
+            cache.read(header.indexOffset + (long long)i * sizeof(DbIndexEntry), &e, sizeof(e));
+            string name = readName(e.nameOffset, e.nameLength);
+            if (name.compare(0, prefix.size(), prefix) != 0) break;
+            out[found++] = name;
+        }
+        return found;
+    }
+
+    int leaderboardId(int rank) {
+        int id;
+        cache.read(header.leaderboardOffset + (long long)rank * sizeof(int), &id, sizeof(id));
+        return id;
+    }
+
+    DbResult result(int i) {
+        DbResult r;
+        cache.read(header.resultsOffset + (long long)i * sizeof(DbResult), &r, sizeof(r));
+        return r;
+    }
+};
+
+
+struct TeamIdBefore {
+    const Team* teams;
+    bool byName;
+    bool operator()(int x, int y) const {
+        return byName ? teams[x].name < teams[y].name : teams[x].rating > teams[y].rating;
+    }
+};
+
+// Stable sort of team ids, by name (ascending) or by rating (descending)
+void sortTeamIds(int* ids, int n, const Team* teams, bool byName) {
+    int* scratch = new int[n > 0 ? n : 1];
+    TeamIdBefore before = { teams, byName };
+    stableMergeSort(ids, scratch, n, before);
+    delete[] scratch;
+}
+
+
+// xorshift32: cheap, and private to whoever owns it, so forks, groups and
+// round engines can each draw their own stream in parallel
+struct XorShiftRng {
+    unsigned int state = 2463534242u;
+    void seed(unsigned int s) { state = s ? s : 1; }
+    float next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return (state & 0xFFFFFF) / (float)0x1000000;
+    }
+};
+
+// The one match model every simulation shares: `a` beats `b` with
+// probability proportional to its rating. Works with any RNG that has next().
+template <class Rng>
+bool firstTeamWins(Rng& rng, float ratingA, float ratingB) {
+    float total = ratingA + ratingB;
+    if (total <= 0) total = 1;
+    return rng.next() < ratingA / total;
+}
+
+
+// Read-only view of the real teams that every what-if fork reads through.
+// It wraps the live hash table, which nothing writes to while an analysis
+// runs, so starting a what-if copies no team data.
+class ForkBase {
+public:
+    const TeamHashTable& live;
+    int count;
+
+    ForkBase(const TeamHashTable& ht) : live(ht), count(0) {
+        for (int b = 0; b < TeamHashTable::bucketCount(); ++b)
+            for (const Node* n = ht.chainAt(b); n; n = n->next) count++;
+    }
+};
+
+
+// One layer of team changes on top of its parent. A layer is frozen as soon
+// as a fork is taken from it and is then shared (reference counted) by every
+// descendant, so forking copies nothing.
+struct ForkLayer {
+    ForkLayer* parent;
+    NameIndexMap index; // Name -> slot in `changed`
+    Team* changed;
+    int count;
+    int capacity;
+    int depth;          // Layers from here down to the base
+    atomic<int> refs;
+
+    ForkLayer(ForkLayer* p)
+        : parent(p), changed(NULL), count(0), capacity(0), depth(p ? p->depth + 1 : 1), refs(1) {
+        if (parent) parent->refs++;
+    }
+    ~ForkLayer() { if (changed) delete[] changed; }
+
+    void store(const Team& t) {
+        int slot = index.get(t.name);
+        if (slot == -1) {
+            if (count == capacity) {
+                int newCapacity = capacity ? capacity * 2 : 8;
+                Team* bigger = new Team[newCapacity];
+                for (int i = 0; i < count; ++i) bigger[i] = changed[i];
+                if (changed) delete[] changed;
+                changed = bigger;
+                capacity = newCapacity;
+            }
+            slot = count++;
+            index.put(t.name, slot);
+        }
+        changed[slot] = t;
+    }
+
+    static void release(ForkLayer* layer) {
+        while (layer && --layer->refs == 0) {
+            ForkLayer* parent = layer->parent;
+            delete layer;
+            layer = parent;
+        }
+    }
+};
+
+
+// A hypothetical branch of the tournament. Costs O(changes) memory: reads
+// fall through the layer chain to the shared base, writes go to the top layer.
+class TournamentFork {
+private:
+    static const int MAX_DEPTH = 16; // Deeper chains are flattened on fork
+
+    const ForkBase* base;
+    ForkLayer* top;
+    XorShiftRng rng; // Each fork has its own stream, so forks can run in parallel
+
+    TournamentFork(const ForkBase* b, ForkLayer* parent, unsigned int seed)
+        : base(b), top(new ForkLayer(parent)) { rng.seed(seed); }
+
+    // Newest value of a team whose base record is `real`
+    void resolve(const Team& real, Team& out) const {
+        for (const ForkLayer* l = top; l; l = l->parent) {
+            int slot = l->index.get(real.name);
+            if (slot != -1) {
+                out = l->changed[slot];
+                return;
+            }
+        }
+        out = real;
+    }
+
+    // Collapse the chain into one parentless layer holding the newest values
+    void flatten() {
+        ForkLayer* flat = new ForkLayer(NULL);
+        for (const ForkLayer* l = top; l; l = l->parent) {
+            for (int i = 0; i < l->count; ++i) {
+                if (flat->index.get(l->changed[i].name) == -1) flat->store(l->changed[i]);
+            }
+        }
+        ForkLayer::release(top);
+        top = flat;
+    }
+
+    void applyTo(Team w, Team l, float ratingChange) {
+        w.wins++;
+        w.rating += ratingChange;
+        l.losses++;
+        put(w);
+        put(l);
+    }
+
+public:
+    TournamentFork(const ForkBase* b, unsigned int seed)
+        : base(b), top(new ForkLayer(NULL)) { rng.seed(seed); }
+    ~TournamentFork() { ForkLayer::release(top); }
+
+    // O(1): freeze our layer and give both sides a fresh one on top of it.
+    // An empty layer has nothing to freeze, so the child shares its parent.
+    TournamentFork* fork(unsigned int seed) {
+        if (top->count == 0) return new TournamentFork(base, top->parent, seed);
+        if (top->depth >= MAX_DEPTH) flatten();
+
+        ForkLayer* frozen = top;
+        TournamentFork* child = new TournamentFork(base, frozen, seed);
+        top = new ForkLayer(frozen);
+        ForkLayer::release(frozen); // Now owned by the two new layers
+        return child;
+    }
+
+    bool get(const string& name, Team& out) const {
+        for (const ForkLayer* l = top; l; l = l->parent) {
+            int slot = l->index.get(name);
+            if (slot != -1) {
+                out = l->changed[slot];
+                return true;
+            }
+        }
+        const Team* real = base->live.find(name);
+        if (!real) return false;
+        out = *real;
+        return true;
+    }
+
+    void put(const Team& t) { top->store(t); }
+
+    void applyResult(const string& winner, const string& loser, float ratingChange) {
+        Team w, l;
+        if (!get(winner, w) || !get(loser, l)) return;
+        applyTo(w, l, ratingChange);
+    }
+
+    // Undo one "winner beat loser" result (the reverse of applyResult)
+    void revertResult(const string& winner, const string& loser, float ratingChange) {
+        Team w, l;
+        if (!get(winner, w) || !get(loser, l)) return;
+        w.wins--;
+        w.rating -= ratingChange;
+        l.losses--;
+        put(w);
+        put(l);
+    }
+
+    // Seeded round, same rules as Tournament::schedule + simulate
+    void simulateRound(float ratingChange) {
+        int n = base->count;
+        if (n < 2) return;
+        Team* field = new Team[n];
+        int filled = 0;
+        for (int b = 0; b < TeamHashTable::bucketCount(); ++b)
+            for (const Node* t = base->live.chainAt(b); t; t = t->next) resolve(t->data, field[filled++]);
+        mergeSort(field, 0, n - 1);
+
+        // Every team plays once per round, so field[] is current when applied
+        for (int i = 0; i + 1 < n; i += 2) {
+            bool firstWins = firstTeamWins(rng, field[i].rating, field[i + 1].rating);
+            const Team& w = firstWins ? field[i] : field[i + 1];
+            const Team& l = firstWins ? field[i + 1] : field[i];
+            applyTo(w, l, ratingChange);
+        }
+        if (n % 2 == 1) {
+            Team bye = field[n - 1];
+            bye.wins++;
+            bye.rating += ratingChange;
+            put(bye);
+        }
+        delete[] field;
+    }
+
+    // Highest-rated team in this branch
+    string leader() const {
+        string best;
+        float bestRating = 0;
+        Team t;
+        for (int b = 0; b < TeamHashTable::bucketCount(); ++b) {
+            for (const Node* n = base->live.chainAt(b); n; n = n->next) {
+                resolve(n->data, t);
+                if (best.empty() || t.rating > bestRating) {
+                    best = t.name;
+                    bestRating = t.rating;
+                }
+            }
+        }
+        return best;
+    }
+
+    int changes() const {
+        int total = 0;
+        for (const ForkLayer* l = top; l; l = l->parent) total += l->count;
+        return total;
+    }
+};
+
+
+// Workers pull fork indices from a shared counter until all are simulated
+void simulateForks(TournamentFork** forks, int forkCount, atomic<int>* nextFork,
+                   int rounds, float ratingChange) {
+    int i;
+    while ((i = (*nextFork)++) < forkCount) {
+        for (int r = 0; r < rounds; ++r) forks[i]->simulateRound(ratingChange);
+    }
+}
+
+void runForksInParallel(TournamentFork** forks, int forkCount, int rounds, float ratingChange) {
+    int threads = (int)thread::hardware_concurrency();
+    if (threads < 1) threads = 1;
+    if (threads > forkCount) threads = forkCount;
+
+    atomic<int> nextFork(0);
+    thread* workers = new thread[threads];
+    for (int t = 0; t < threads; ++t)
+        workers[t] = thread(simulateForks, forks, forkCount, &nextFork, rounds, ratingChange);
+    for (int t = 0; t < threads; ++t) workers[t].join();
+    delete[] workers;
+}
+
+
+/* ----- COMPILE-TIME SPECIALIZED ROUND ENGINES ----- */
+// A round engine is assembled from policies:
+// storage layout, rating rule, pairing rule, RNG and instrumentation.
+// Every choice is resolved at compile time, so the hot loop has no name
+// lookups, no runtime branches on configuration and no virtual calls.
+
+// Bracket order for a power-of-two field, computed at compile time:
+// seed[2i] plays seed[2i+1] (1 v N, N/2 v N/2+1, ...), standard layout.
+template <int N>
+struct BracketLayout {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "Bracket size must be a power of two");
+    int seed[N];
+    constexpr BracketLayout() : seed() {
+        int size = 1;
+        while (size < N) {
+            for (int i = size - 1; i >= 0; --i) {
+                int s = seed[i];
+                seed[2 * i] = s;
+                seed[2 * i + 1] = 2 * size - 1 - s;
+            }
+            size *= 2;
+        }
+    }
+};
+
+// Storage: fixed in-place array for a known field size
+template <int N>
+struct FixedArrayStorage {
+    Team teams[N];
+    int count = 0;
+
+    int size() const { return count; }
+    Team& at(int i) { return teams[i]; }
+    const Team& at(int i) const { return teams[i]; }
+    void add(const Team& t) { if (count < N) teams[count++] = t; }
+};
+
+// Storage: growable array + hashed name index for open fields
+struct HashedStorage {
+    Team* teams = NULL;
+    int count = 0;
+    int capacity = 0;
+    NameIndexMap index;
+
+    ~HashedStorage() { if (teams) delete[] teams; }
+    int size() const { return count; }
+    Team& at(int i) { return teams[i]; }
+    const Team& at(int i) const { return teams[i]; }
+    void add(const Team& t) {
+        if (index.get(t.name) != -1) return;
+        if (count == capacity) {
+            capacity = capacity ? capacity * 2 : 64;
+            Team* bigger = new Team[capacity];
+            for (int i = 0; i < count; ++i) bigger[i] = teams[i];
+            if (teams) delete[] teams;
+            teams = bigger;
+        }
+        index.put(t.name, count);
+        teams[count++] = t;
+    }
+};
+
+// Rating: constant winner bonus of NUM/DEN, folded into a constant
+template <int NUM, int DEN>
+struct ConstantBonus {
+    static constexpr float bonus = (float)NUM / DEN;
+    static void apply(Team& w, Team& l) {
+        w.wins++;
+        w.rating += bonus;
+        l.losses++;
+    }
+    // Play one match and apply it; true when `a` won
+    template <class Rng>
+    static bool play(Rng& rng, Team& a, Team& b) {
+        bool firstWins = firstTeamWins(rng, a.rating, b.rating);
+        if (firstWins) apply(a, b);
+        else apply(b, a);
+        return firstWins;
+    }
+};
+
+// Pairing: adjacent seeds (Swiss-style, same rule as schedule())
+struct AdjacentSeedPairing {
+    // order[] holds team indices sorted by rating; writes n/2 pairs
+    static int pair(const int* order, int n, int* pairs) {
+        for (int i = 0; i + 1 < n; i += 2) {
+            pairs[i] = order[i];
+            pairs[i + 1] = order[i + 1];
+        }
+        return n / 2;
+    }
+};
+
+// Pairing: fixed power-of-two knockout bracket from a constexpr table
+template <int N>
+struct BracketPairing {
+    static constexpr BracketLayout<N> layout{};
+    static int pair(const int* order, int n, int* pairs) {
+        if (n != N) return AdjacentSeedPairing::pair(order, n, pairs);
+        for (int i = 0; i < N; ++i) pairs[i] = order[layout.seed[i]];
+        return N / 2;
+    }
+};
+
+// RNG: xorshift32 (XorShiftRng, shared with the what-if forks)
+
+// RNG: the C library rand(), as used by simulate() (shares its seed)
+struct StdRng {
+    void seed(unsigned int s) { srand(s); }
+    float next() { return (float)rand() / RAND_MAX; }
+};
+
+
+template <class Storage, class Rating, class Pairing, class Rng, bool Instrumented>
+class RoundEngine {
+private:
+    Storage storage;
+    Rng rng;
+    int* order = NULL;
+    int* scratch = NULL;
+    int* pairs = NULL;
+    int bufferSize = 0;
+
+    struct HigherRating {
+        Storage& storage;
+        bool operator()(int x, int y) const { return storage.at(x).rating > storage.at(y).rating; }
+    };
+
+    // Stable sort of team indices, highest rating first
+    void sortByRating(int n) {
+        for (int i = 0; i < n; ++i) order[i] = i;
+        HigherRating before = { storage };
+        stableMergeSort(order, scratch, n, before);
+    }
+
+public:
+    long long matchesPlayed = 0; // Only maintained when Instrumented
+    long long upsets = 0;
+
+    ~RoundEngine() {
+        if (order) delete[] order;
+        if (scratch) delete[] scratch;
+        if (pairs) delete[] pairs;
+    }
+
+    void seed(unsigned int s) { rng.seed(s); }
+    void addTeam(const Team& t) { storage.add(t); }
+    int size() const { return storage.size(); }
+    const Team& team(int i) const { return storage.at(i); }
+
+    // One match under this configuration's rules: applies the result and
+    // returns true when `a` won
+    bool playMatch(Team& a, Team& b) {
+        bool firstWins = Rating::play(rng, a, b);
+
+        if constexpr (Instrumented) {
+            matchesPlayed++;
+            if ((firstWins && a.rating - Rating::bonus < b.rating) ||
+                (!firstWins && b.rating - Rating::bonus < a.rating)) upsets++;
+        }
+        return firstWins;
+    }
+
+    void playRound() {
+        int n = storage.size();
+        if (n < 2) return;
+        if (n > bufferSize) {
+            if (order) delete[] order;
+            if (scratch) delete[] scratch;
+            if (pairs) delete[] pairs;
+            order = new int[n];
+            scratch = new int[n];
+            pairs = new int[n];
+            bufferSize = n;
+        }
+        sortByRating(n);
+        int matchCount = Pairing::pair(order, n, pairs);
+
+        for (int m = 0; m < matchCount; ++m) playMatch(storage.at(pairs[2 * m]), storage.at(pairs[2 * m + 1]));
+    }
+};
+
+// Preinstantiated configurations
+typedef RoundEngine<FixedArrayStorage<64>, ConstantBonus<3, 2>, BracketPairing<64>, XorShiftRng, false> SmallCupEngine;
+typedef RoundEngine<HashedStorage, ConstantBonus<3, 2>, AdjacentSeedPairing, XorShiftRng, false> OpenSwissEngine;
+typedef RoundEngine<HashedStorage, ConstantBonus<3, 2>, AdjacentSeedPairing, XorShiftRng, true> OpenSwissInstrumentedEngine;
+
+
+// The general path everything else pays for: teams reached through
+// TeamHashTable nodes, a runtime bonus and a runtime seeding rule. Sort,
+// buffers, RNG and match model are the same as RoundEngine's, so the
+// benchmark measures only what specialization removes.
+class GenericRoundEngine {
+private:
+    TeamHashTable table;
+    Team** teams = NULL; // Into the table's nodes, which never move
+    int count = 0;
+    int capacity = 0;
+    float ratingBonus;
+    bool bracketSeeding;
+    XorShiftRng rng;
+    int* order = NULL;
+    int* scratch = NULL;
+    int* pairs = NULL;
+    int* slot = NULL;
+    int bufferSize = 0;
+    int bracketSize = 0; // Field size `slot` was laid out for
+
+    struct HigherRating {
+        Team** teams;
+        bool operator()(int x, int y) const { return teams[x]->rating > teams[y]->rating; }
+    };
+
+public:
+    GenericRoundEngine(float bonus, bool bracket) : ratingBonus(bonus), bracketSeeding(bracket) {}
+    ~GenericRoundEngine() {
+        if (teams) delete[] teams;
+        if (order) delete[] order;
+        if (scratch) delete[] scratch;
+        if (pairs) delete[] pairs;
+        if (slot) delete[] slot;
+    }
+
+    void addTeam(const Team& t) {
+        if (table.find(t.name)) return;
+        table.insert(t);
+        if (count == capacity) {
+            capacity = capacity ? capacity * 2 : 64;
+            Team** bigger = new Team*[capacity];
+            for (int i = 0; i < count; ++i) bigger[i] = teams[i];
+            if (teams) delete[] teams;
+            teams = bigger;
+        }
+        teams[count++] = table.find(t.name);
+    }
+
+    int size() const { return count; }
+    const Team& team(int i) const { return *teams[i]; }
+
+    void playRound() {
+        int n = count;
+        if (n < 2) return;
+        if (n > bufferSize) {
+            if (order) delete[] order;
+            if (scratch) delete[] scratch;
+            if (pairs) delete[] pairs;
+            if (slot) delete[] slot;
+            order = new int[n];
+            scratch = new int[n];
+            pairs = new int[n];
+            slot = new int[n];
+            bufferSize = n;
+            bracketSize = 0;
+        }
+        for (int i = 0; i < n; ++i) order[i] = i;
+        HigherRating before = { teams };
+        stableMergeSort(order, scratch, n, before);
+
+        // Seeding rule chosen at runtime; the bracket is laid out once per field size
+        bool bracket = bracketSeeding && (n & (n - 1)) == 0;
+        if (bracket && bracketSize != n) {
+            slot[0] = 0;
+            for (int size = 1; size < n; size *= 2) {
+                for (int i = size - 1; i >= 0; --i) {
+                    int s = slot[i];
+                    slot[2 * i] = s;
+                    slot[2 * i + 1] = 2 * size - 1 - s;
+                }
+            }
+            bracketSize = n;
+        }
+        int matchCount = n / 2;
+        for (int i = 0; i < 2 * matchCount; ++i) pairs[i] = order[bracket ? slot[i] : i];
+
+        for (int m = 0; m < matchCount; ++m) {
+            Team& a = *teams[pairs[2 * m]];
+            Team& b = *teams[pairs[2 * m + 1]];
+            bool firstWins = firstTeamWins(rng, a.rating, b.rating);
+            Team& w = firstWins ? a : b;
+            Team& l = firstWins ? b : a;
+            w.wins++;
+            w.rating += ratingBonus;
+            l.losses++;
+        }
+    }
+};
+
+
+// Both engines play the same rules from the same RNG state, so after the
+// same rounds every team must have the same record
+template <class Specialized>
+bool sameResults(const Specialized& fast, const GenericRoundEngine& slow) {
+    if (fast.size() != slow.size()) return false;
+    for (int i = 0; i < fast.size(); ++i) {
+        const Team& a = fast.team(i);
+        const Team& b = slow.team(i);
+        if (a.wins != b.wins || a.losses != b.losses || a.rating != b.rating) return false;
+    }
+    return true;
+}
+
+template <class Engine>
+double timeRounds(Engine& engine, int rounds) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) engine.playRound();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+void benchmarkSpecializedEngines() {
+    cout << endl << "=== SPECIALIZED vs GENERIC ROUND ENGINES ===" << endl;
+
+    {
+        const int ROUNDS = 20000;
+        SmallCupEngine* cup = new SmallCupEngine();
+        GenericRoundEngine generic(1.5f, true);
+        for (int i = 0; i < 64; ++i) {
+            Team t("Cup" + to_string(i), 50 + rand() % 50);
+            cup->addTeam(t);
+            generic.addTeam(t);
+        }
+        double fast = timeRounds(*cup, ROUNDS);
+        double slow = timeRounds(generic, ROUNDS);
+        cout << "64-team cup, " << ROUNDS << " rounds | specialized " << fast
+             << " ms | generic " << slow << " ms | speedup " << slow / fast << "x"
+             << (sameResults(*cup, generic) ? "" : " | RESULTS DIFFER") << endl;
+        delete cup;
+    }
+
+    {
+        const int TEAMS = 5000, ROUNDS = 50;
+        OpenSwissEngine swiss;
+        OpenSwissInstrumentedEngine instrumented;
+        GenericRoundEngine generic(1.5f, false);
+        for (int i = 0; i < TEAMS; ++i) {
+            Team t("Open" + to_string(i), 50 + rand() % 50);
+            swiss.addTeam(t);
+            instrumented.addTeam(t);
+            generic.addTeam(t);
+        }
+        double fast = timeRounds(swiss, ROUNDS);
+        double traced = timeRounds(instrumented, ROUNDS);
+        double slow = timeRounds(generic, ROUNDS);
+        cout << TEAMS << "-team open Swiss, " << ROUNDS << " rounds | specialized " << fast
+             << " ms | instrumented " << traced << " ms (" << instrumented.upsets << " upsets in "
+             << instrumented.matchesPlayed << " matches) | generic " << slow
+             << " ms | speedup " << slow / fast << "x"
+             << (sameResults(swiss, generic) ? "" : " | RESULTS DIFFER") << endl;
+    }
+    cout << "============================================" << endl;
+}
+
+
+// Mergeable fixed-bucket histogram with a Fenwick tree over the bucket
+// counts. Values can be removed as well as added, so ratings that move
+// (simulate) or move back (undo) are kept exact; quantile and
+// "percentile of x" queries cost O(log buckets) whatever the field size.
+// Values past either end land in the edge buckets.
+class StreamingHistogram {
+private:
+    double lo, width;
+    int buckets;
+    long long* counts;
+    long long* tree; // Fenwick tree, 1-based
+    long long total;
+    double sum, sumSq;
+    double minSeen, maxSeen; // Bounds on the values held; exact until an extreme is removed
+
+    int bucketOf(double v) const {
+        int b = (int)((v - lo) / width);
+        if (b < 0) b = 0;
+        if (b >= buckets) b = buckets - 1;
+        return b;
+    }
+
+    void bump(int b, long long delta) {
+        counts[b] += delta;
+        for (int i = b + 1; i <= buckets; i += i & (-i)) tree[i] += delta;
+    }
+
+    // Number of values in buckets [0, b)
+    long long prefix(int b) const {
+        long long c = 0;
+        for (int i = b; i > 0; i -= i & (-i)) c += tree[i];
+        return c;
+    }
+
+    // Fenwick descent: bucket holding the value of rank `target` (1-based);
+    // `seen` gets the number of values in the buckets before it
+    int bucketOfRank(long long target, long long& seen) const {
+        int pos = 0;
+        seen = 0;
+        int step = 1;
+        while (step * 2 <= buckets) step *= 2;
+        for (; step > 0; step /= 2) {
+            if (pos + step <= buckets && seen + tree[pos + step] < target) {
+                pos += step;
+                seen += tree[pos];
+            }
+        }
+        return pos;
+    }
+
+    // After a removal, pull the bounds in to the occupied edge buckets
+    void tightenBounds() {
+        long long seen;
+        int first = bucketOfRank(1, seen);
+        int last = bucketOfRank(total, seen);
+        if (first > 0 && minSeen < lo + width * first) minSeen = lo + width * first;
+        if (last < buckets - 1 && maxSeen > lo + width * (last + 1)) maxSeen = lo + width * (last + 1);
+    }
+
+public:
+    StreamingHistogram(double low, double bucketWidth, int bucketCount)
+        : lo(low), width(bucketWidth), buckets(bucketCount), total(0), sum(0), sumSq(0), minSeen(0), maxSeen(0) {
+        counts = new long long[buckets];
+        tree = new long long[buckets + 1];
+        clear();
+    }
+    ~StreamingHistogram() {
+        delete[] counts;
+        delete[] tree;
+    }
+
+    void clear() {
+        for (int i = 0; i < buckets; ++i) counts[i] = 0;
+        for (int i = 0; i <= buckets; ++i) tree[i] = 0;
+        total = 0;
+        sum = sumSq = 0;
+        minSeen = maxSeen = 0;
+    }
+
+    void add(double v) {
+        if (total == 0 || v < minSeen) minSeen = v;
+        if (total == 0 || v > maxSeen) maxSeen = v;
+        bump(bucketOf(v), 1);
+        total++;
+        sum += v;
+        sumSq += v * v;
+    }
+
+    void remove(double v) {
+        int b = bucketOf(v);
+        if (counts[b] == 0) return;
+        bump(b, -1);
+        total--;
+        sum -= v;
+        sumSq -= v * v;
+        if (total == 0) minSeen = maxSeen = 0;
+        else if (v <= minSeen || v >= maxSeen) tightenBounds();
+    }
+
+    // Combine another shard/thread's summary (same bucket layout)
+    void merge(const StreamingHistogram& other) {
+        if (other.buckets != buckets || other.lo != lo || other.width != width) return;
+        if (other.total == 0) return;
+        if (total == 0 || other.minSeen < minSeen) minSeen = other.minSeen;
+        if (total == 0 || other.maxSeen > maxSeen) maxSeen = other.maxSeen;
+        for (int b = 0; b < buckets; ++b) if (other.counts[b]) bump(b, other.counts[b]);
+        total += other.total;
+        sum += other.sum;
+        sumSq += other.sumSq;
+    }
+
+    long long count() const { return total; }
+    double mean() const { return total ? sum / total : 0; }
+    double stddev() const {
+        if (total < 2) return 0;
+        double m = mean();
+        double var = sumSq / total - m * m;
+        return var > 0 ? sqrt(var) : 0;
+    }
+
+    // Value at quantile q in [0, 1], interpolated inside the bucket and
+    // never outside the range of values actually held
+    double quantile(double q) const {
+        if (total == 0) return 0;
+        long long target = (long long)ceil(q * total); // Nearest rank
+        if (target < 1) target = 1;
+        if (target > total) target = total;
+        long long seen;
+        int pos = bucketOfRank(target, seen);
+        double within = counts[pos] ? (double)(target - seen - 0.5) / counts[pos] : 0.5;
+        double v = lo + width * (pos + within);
+        if (v < minSeen) v = minSeen;
+        if (v > maxSeen) v = maxSeen;
+        return v;
+    }
+
+    // Share of values below v, in percent (ties count half)
+    double percentileOf(double v) const {
+        if (total == 0) return 0;
+        int b = bucketOf(v);
+        return 100.0 * (prefix(b) + counts[b] / 2.0) / total;
+    }
+
+    // `bands` equal-width bands between the lowest and highest occupied bucket
+    void showBands(int bands) const {
+        if (total == 0) return;
+        int first = 0, last = buckets - 1;
+        while (counts[first] == 0) first++;
+        while (counts[last] == 0) last--;
+        int per = (last - first) / bands + 1;
+        for (int b = first; b <= last; b += per) {
+            int end = (b + per - 1 < last) ? b + per - 1 : last;
+            long long c = prefix(end + 1) - prefix(b);
+            cout << "  [" << lo + width * b << ", " << lo + width * (end + 1) << "): ";
+            int bar = (int)(40.0 * c / total + 0.5);
+            for (int i = 0; i < bar; ++i) cout << '#';
+            cout << " " << c << endl;
+        }
+    }
+};
+
+
+// One group of a multi-division event. Owns a private copy of its teams,
+// its own result list and its own RNG, so groups share nothing while they
+// are being simulated.
+class Group {
+public:
+    Team* teams;
+    int count, capacity;
+    int* winners;  // Local team index per match
+    int* losers;
+    int resultCount;
+    XorShiftRng rng;
+
+    Group() : teams(NULL), count(0), capacity(0), winners(NULL), losers(NULL), resultCount(0) {}
+    ~Group() {
+        if (teams) delete[] teams;
+        if (winners) delete[] winners;
+        if (losers) delete[] losers;
+    }
+
+    void init(int cap, unsigned int seed) {
+        capacity = cap;
+        teams = new Team[capacity];
+        rng.seed(seed);
+    }
+
+    void add(const Team& t) { if (count < capacity) teams[count++] = t; }
+
+    // Results grow with the square of the group size (8 bytes per match);
+    // this caps a group's round robin at 128 MB of results, about 5,800 teams
+    static const long long MAX_MATCHES = 1LL << 24;
+    static long long matchesFor(long long teams) { return teams * (teams - 1) / 2; }
+
+    // Single round robin with the usual rating-based win probability.
+    // The RNG and result counter live in locals while the group plays:
+    // neighbouring Groups share cache lines, and other threads are
+    // playing them at the same time.
+    void playRoundRobin(float ratingChange) {
+        long long needed = resultCount + matchesFor(count);
+        if (needed > MAX_MATCHES) return; // GroupStage callers reject such sizes up front
+        int* w2 = new int[needed > 0 ? needed : 1];
+        int* l2 = new int[needed > 0 ? needed : 1];
+        for (int m = 0; m < resultCount; ++m) {
+            w2[m] = winners[m];
+            l2[m] = losers[m];
+        }
+        if (winners) delete[] winners;
+        if (losers) delete[] losers;
+        winners = w2;
+        losers = l2;
+
+        XorShiftRng local = rng;
+        int played = resultCount;
+        for (int i = 0; i < count; ++i) {
+            for (int j = i + 1; j < count; ++j) {
+                bool firstWins = firstTeamWins(local, teams[i].rating, teams[j].rating);
+                int w = firstWins ? i : j;
+                int l = firstWins ? j : i;
+                teams[w].wins++;
+                teams[w].rating += ratingChange;
+                teams[l].losses++;
+                winners[played] = w;
+                losers[played] = l;
+                played++;
+            }
+        }
+        rng = local;
+        resultCount = played;
+    }
+
+    // Local indices in standings order: group wins, then rating
+    void standings(int* order, const int* baseWins) const {
+        for (int i = 0; i < count; ++i) order[i] = i;
+        for (int i = 1; i < count; ++i) { // Insertion sort, groups are small
+            int cur = order[i];
+            int k = i - 1;
+            while (k >= 0 && better(cur, order[k], baseWins)) {
+                order[k + 1] = order[k];
+                k--;
+            }
+            order[k + 1] = cur;
+        }
+    }
+
+    bool better(int a, int b, const int* baseWins) const {
+        int wa = teams[a].wins - baseWins[a], wb = teams[b].wins - baseWins[b];
+        if (wa != wb) return wa > wb;
+        return teams[a].rating > teams[b].rating;
+    }
+};
+
+
+void playGroups(Group* groups, int groupCount, atomic<int>* nextGroup, float ratingChange) {
+    int g;
+    while ((g = (*nextGroup)++) < groupCount) groups[g].playRoundRobin(ratingChange);
+}
+
+
+// Splits the field into snake-seeded groups, plays every group's round robin
+// concurrently on a thread pool, then merges the standings into one global
+// seeding for the knockout phase.
+class GroupStage {
+public:
+    Group* groups;
+    int groupCount;
+    int** startWins; // Wins before the group stage, per group and local index
+
+    GroupStage(Team* field, int n, int groupsWanted) : groupCount(groupsWanted) {
+        mergeSort(field, 0, n - 1);
+        groups = new Group[groupCount];
+        startWins = new int*[groupCount];
+        int perGroup = (n + groupCount - 1) / groupCount;
+        for (int g = 0; g < groupCount; ++g) {
+            groups[g].init(perGroup, (unsigned int)rand());
+            startWins[g] = new int[perGroup];
+        }
+        // Snake seeding: 1..G, then G..1, so every group gets a fair mix
+        for (int i = 0; i < n; ++i) {
+            int tier = i / groupCount, pos = i % groupCount;
+            int g = (tier % 2 == 0) ? pos : groupCount - 1 - pos;
+            startWins[g][groups[g].count] = field[i].wins;
+            groups[g].add(field[i]);
+        }
+    }
+    ~GroupStage() {
+        for (int g = 0; g < groupCount; ++g) delete[] startWins[g];
+        delete[] startWins;
+        delete[] groups;
+    }
+
+    void run(float ratingChange) {
+        int threads = (int)thread::hardware_concurrency();
+        if (threads < 1) threads = 1;
+        if (threads > groupCount) threads = groupCount;
+        atomic<int> nextGroup(0);
+        thread* workers = new thread[threads];
+        for (int t = 0; t < threads; ++t)
+            workers[t] = thread(playGroups, groups, groupCount, &nextGroup, ratingChange);
+        for (int t = 0; t < threads; ++t) workers[t].join();
+        delete[] workers;
+    }
+
+    // Top `advance` of every group, as one global seeding: all group
+    // winners first, then all runners-up, ... each tier ordered by group
+    // wins and rating. Returns the number of seeded teams.
+    int seeding(int advance, Team* out) const {
+        int seeded = 0;
+        int* order = new int[groups[0].capacity];
+        for (int place = 0; place < advance; ++place) {
+            int tierStart = seeded;
+            for (int g = 0; g < groupCount; ++g) {
+                if (place >= groups[g].count) continue;
+                groups[g].standings(order, startWins[g]);
+                out[seeded] = groups[g].teams[order[place]];
+                out[seeded].wins -= startWins[g][order[place]]; // Group wins, for ordering
+                seeded++;
+            }
+            // Order the tier (insertion sort by group wins, then rating)
+            for (int i = tierStart + 1; i < seeded; ++i) {
+                Team cur = out[i];
+                int k = i - 1;
+                while (k >= tierStart && (out[k].wins < cur.wins ||
+                       (out[k].wins == cur.wins && out[k].rating < cur.rating))) {
+                    out[k + 1] = out[k];
+                    k--;
+                }
+                out[k + 1] = cur;
+            }
+        }
+        delete[] order;
+        return seeded;
+    }
+};
+
+
+// Bounded lock-free single-producer/single-consumer ring buffer used to
+// connect pipeline stages. Producers spin (yielding) when it is full, which
+// is counted as backpressure; consumers count waits on an empty ring.
+template <typename T>
+class SpscRing {
+private:
+    T* slots;
+    long long capacity;
+    atomic<long long> head; // Next slot to read (consumer)
+    atomic<long long> tail; // Next slot to write (producer)
+    atomic<bool> closed;
+
+public:
+    long long fullWaits;  // Producer side only
+    long long emptyWaits; // Consumer side only
+
+    SpscRing(long long cap) : capacity(cap), head(0), tail(0), closed(false), fullWaits(0), emptyWaits(0) {
+        slots = new T[capacity];
+    }
+    ~SpscRing() { delete[] slots; }
+
+    void push(const T& item) {
+        long long t = tail.load(memory_order_relaxed);
+        if (t - head.load(memory_order_acquire) == capacity) {
+            fullWaits++; // Once per blocked push, however long it spins
+            do {
+                this_thread::yield();
+            } while (t - head.load(memory_order_acquire) == capacity);
+        }
+        slots[t % capacity] = item;
+        tail.store(t + 1, memory_order_release);
+    }
+
+    // False once the producer has closed the ring and it is drained
+    bool pop(T& out) {
+        long long h = head.load(memory_order_relaxed);
+        bool waited = false;
+        while (h == tail.load(memory_order_acquire)) {
+            if (closed.load(memory_order_acquire) && h == tail.load(memory_order_acquire)) return false;
+            if (!waited) emptyWaits++; // Once per blocked pop
+            waited = true;
+            this_thread::yield();
+        }
+        out = slots[h % capacity];
+        head.store(h + 1, memory_order_release);
+        return true;
+    }
+
+    void close() { closed.store(true, memory_order_release); }
+};
+
+
+// Per-stage throughput and backpressure counters for the round pipeline
+struct StageMetrics {
+    string name;
+    long long items;
+    double seconds;
+    long long blockedOnOutput; // Pushes that found the next ring full
+    long long waitedOnInput;   // Pops that found the previous ring empty
+
+    StageMetrics() : items(0), seconds(0), blockedOnOutput(0), waitedOnInput(0) {}
+
+    void show() const {
+        cout << name << ": " << items << " items | "
+             << (long long)(items / (seconds > 0 ? seconds : 1e-9)) << " items/sec | "
+             << "backpressure " << blockedOnOutput << " | starved " << waitedOnInput << endl;
+    }
+};
+
+// Messages passed between pipeline stages
+struct PipelinePair {
+    Team a, b;
+    bool bye;
+};
+
+struct PipelineResult {
+    string winner, loser; // loser == "bye" for a bye
+    float ratingChange;
+    float winnerRating;   // Filled in by the commit stage
+};
+
+
+class Tournament {
+public:
+    LinkedList teamsLL; 
+    TeamHashTable teamsHT; 
+    Queue matches;
+    Stack undo; 
+    BST results; 
+    Graph performanceGraph; 
+    TournamentTree tourneyTree; 
+    PowerRanker ranker;
+    RatingHistory history;
+    NameTrie nameSearch;
+    StreamingHistogram ratingDist = StreamingHistogram(-1024, 0.25, 32768);
+    StreamingHistogram winRateDist = StreamingHistogram(0, 0.01, 100); // 1.0 falls in [0.99, 1]
+    int currentRound = 0; // Incremented by every simulated round
+    int historyStart = 0; // Rating history only covers rounds from here on
+    // Match rule for every live path (simulate, pipeline, forks, groups)
+    typedef ConstantBonus<3, 2> RatingRule;
+    static constexpr float ratingBonus = RatingRule::bonus; // 1.5
+
+    Team* allTeamsArray = NULL; 
+    int currentTeamCount = 0;
+
+    // Lazy-open mode (see openLazy)
+    LazyTeamStore* lazy = NULL;
+    bool* lazyLoaded = NULL;  // Per record id, allocated on first use
+    bool lazyDirty = false;   // Teams added since opening
+    bool lazyNamesLoaded = false; // Whole name index is in nameSearch
+    bool lazyStatsLoaded = false; // Every saved team is counted in the histograms
+    bool lazyTouched[5] = { false, false, false, false, false };
+
+    Tournament() {
+        tourneyTree.root = new TournamentTree::TNode("Champion");
+    }
+    ~Tournament() {
+        if (allTeamsArray) delete[] allTeamsArray;
+        closeLazy(false); // The histograms go away with us
+    }
+
+    /* ----- LAZY OPEN ----- */
+    // Report how long the first access to each on-disk structure took
+    void firstTouch(int part, chrono::steady_clock::time_point start) {
+        if (lazyTouched[part]) return;
+        lazyTouched[part] = true;
+        const char* names[5] = { "name index", "team records", "leaderboard", "graph adjacency", "results" };
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        cout << "[Lazy] First touch of " << names[part] << ": " << ms << " ms" << endl;
+    }
+
+    // Read only the header of teams.db; everything else loads on demand
+    bool openLazy(const string& path) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        LazyTeamStore* store = new LazyTeamStore();
+        if (!store->open(path)) {
+            delete store;
+            return false;
+        }
+        if (!store->layoutValid()) {
+            cout << "[Lazy] " << path << " is damaged; loading teams.txt instead." << endl;
+            delete store;
+            return false;
+        }
+        if (!matchesTextSave(path, store->header)) {
+            cout << "[Lazy] teams.txt changed after " << path << " was written; loading teams.txt instead." << endl;
+            delete store;
+            return false;
+        }
+        lazy = store;
+        restoreRound(lazy->header.round);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        cout << "[Lazy] Opened " << path << " (" << lazy->header.teamCount << " teams) in "
+             << ms << " ms. Records load on first use." << endl;
+        return true;
+    }
+
+    // teams.db is only trusted when it was written together with the
+    // current teams.txt: not older than it, and recorded at its size
+    bool matchesTextSave(const string& path, const DbHeader& h) {
+        struct stat text, db;
+        if (stat("teams.txt", &text) != 0) return true; // Nothing to disagree with
+        if (stat(path.c_str(), &db) != 0) return false;
+        return text.st_mtime <= db.st_mtime && (long long)text.st_size == h.textBytes;
+    }
+
+    // Rounds before the save were played in an earlier session, and rating
+    // history is not saved, so this session's history starts at `round`
+    void restoreRound(int round) {
+        currentRound = round;
+        historyStart = round;
+    }
+
+    // Round stored in teams.db, when it was written with the current teams.txt
+    int savedRound(const string& path) {
+        ifstream f(path.c_str(), ios::binary);
+        DbHeader h;
+        if (!f.read((char*)&h, sizeof(h)) || memcmp(h.magic, DB_MAGIC, sizeof(DB_MAGIC)) != 0) return 0;
+        return matchesTextSave(path, h) ? h.round : 0;
+    }
+
+    // `keepStats` un-counts saved teams that never loaded, which reads each
+    // of their records; skip it when the histograms are being destroyed
+    void closeLazy(bool keepStats = true) {
+        if (lazy && lazyStatsLoaded && keepStats) {
+            // Saved teams that never loaded leave the histograms with the save
+            for (int id = 0; id < lazy->header.teamCount; ++id) {
+                if (lazyLoaded && lazyLoaded[id]) continue;
+                DbRecord rec = lazy->record(id);
+                Team t("", rec.rating);
+                t.wins = rec.wins;
+                t.losses = rec.losses;
+                forgetStats(t);
+            }
+        }
+        if (lazy) delete lazy;
+        if (lazyLoaded) delete[] lazyLoaded;
+        lazy = NULL;
+        lazyLoaded = NULL;
+        lazyDirty = false;
+        lazyNamesLoaded = false;
+        lazyStatsLoaded = false;
+    }
+
+    // Single-team queries can be answered straight from teams.db while
+    // nothing has been registered since it was opened (matches always load
+    // the whole field first, so the save is current)
+    bool lazyClean() const { return lazy && !lazyDirty; }
+
+    void materialize(int id) {
+        if (!lazyLoaded) {
+            lazyLoaded = new bool[lazy->header.teamCount];
+            for (int i = 0; i < lazy->header.teamCount; ++i) lazyLoaded[i] = false;
+        }
+        if (lazyLoaded[id]) return;
+        lazyLoaded[id] = true;
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        DbRecord rec = lazy->record(id);
+        Team t(lazy->nameOf(rec), rec.rating);
+        t.wins = rec.wins;
+        t.losses = rec.losses;
+        teamsLL.addTeam(t);
+        teamsHT.insert(t);
+        if (!lazyStatsLoaded) trackStats(t); // Otherwise already counted
+        performanceGraph.addTeam(t.name);
+        history.record(performanceGraph.indexOf(t.name), currentRound, t.rating);
+        nameSearch.insert(t.name);
+        firstTouch(1, start);
+    }
+
+    // Team by name, pulling it from disk on first access in lazy mode
+    Team* lookupTeam(const string& name) {
+        Team* t = teamsHT.find(name);
+        if (t || !lazy) return t;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        int id = lazy->findRecord(name);
+        firstTouch(0, start);
+        if (id == -1) return NULL;
+        materialize(id);
+        return teamsHT.find(name);
+    }
+
+    // Whole-field operations need everything: teams, graph and results.
+    // Afterwards the session continues in normal (fully loaded) mode.
+    void requireAll() {
+        if (!lazy) return;
+        int n = lazy->header.teamCount;
+        for (int id = 0; id < n; ++id) materialize(id);
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int id = 0; id < n; ++id) {
+            DbRecord rec = lazy->record(id);
+            if (rec.adjCount == 0) continue;
+            string winner = lazy->nameOf(rec);
+            for (int k = 0; k < rec.adjCount; ++k) {
+                DbEdge e = lazy->edge(rec, k);
+                string loser = lazy->nameOf(e.other);
+                for (int w = 0; w < e.wins; ++w) performanceGraph.addMatch(winner, loser);
+            }
+        }
+        firstTouch(3, start);
+
+        start = chrono::steady_clock::now();
+        for (int i = 0; i < lazy->header.resultCount; ++i) {
+            DbResult r = lazy->result(i);
+            results.insert(lazy->nameOf(r.winner), r.loser == -1 ? "bye" : lazy->nameOf(r.loser));
+        }
+        firstTouch(4, start);
+
+        cout << "[Lazy] Fully loaded (" << lazy->cacheMisses() << " page reads, "
+             << lazy->cacheHits() << " cache hits)." << endl;
+        closeLazy();
+    }
+
+    // Fuzzy search needs every name, but not the teams behind them
+    void requireNames() {
+        if (!lazy || lazyNamesLoaded) return;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        int n = lazy->header.teamCount;
+        string* names = new string[n > 0 ? n : 1];
+        for (int id = 0; id < n; ++id) names[id] = lazy->nameOf(id);
+        nameSearch.build(names, n);
+        delete[] names;
+        // build() starts over, so put back teams registered since opening
+        for (int b = 0; b < TeamHashTable::bucketCount(); ++b)
+            for (const Node* t = teamsHT.chainAt(b); t; t = t->next) nameSearch.insert(t->data.name);
+        lazyNamesLoaded = true;
+        firstTouch(0, start);
+    }
+
+    // Histograms need every rating, but not the teams behind them
+    void requireStats() {
+        if (!lazy || lazyStatsLoaded) return;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int id = 0; id < lazy->header.teamCount; ++id) {
+            if (lazyLoaded && lazyLoaded[id]) continue; // Counted when it loaded
+            DbRecord rec = lazy->record(id);
+            Team t("", rec.rating);
+            t.wins = rec.wins;
+            t.losses = rec.losses;
+            trackStats(t);
+        }
+        lazyStatsLoaded = true;
+        firstTouch(1, start);
+    }
+
+    // Head-to-head wins of record `a` over record `b`, from a's defeat list
+    int lazyWins(const DbRecord& a, int b) {
+        for (int k = 0; k < a.adjCount; ++k) {
+            DbEdge e = lazy->edge(a, k);
+            if (e.other == b) return e.wins;
+        }
+        return 0;
+    }
+
+    // Wins of record `b` over the team whose record is `a`, from a's losses
+    int lazyLossesTo(const DbRecord& a, int b) {
+        for (int k = 0; k < a.lossCount; ++k) {
+            DbEdge e = lazy->loss(a, k);
+            if (e.other == b) return e.wins;
+        }
+        return 0;
+    }
+
+    // Graph::checkIndirectWin, showHeadToHead and showOpponents against the
+    // save: only the records the search reaches are read
+    void lazyPerformance(const string& teamA, const string& teamB) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        int a = lazy->findRecord(teamA);
+        int b = lazy->findRecord(teamB);
+        if (a == -1 || b == -1) {
+            cout << "One or both teams not found in the graph." << endl;
+        } else {
+            int n = lazy->header.teamCount;
+            bool* visited = new bool[n];
+            for (int i = 0; i < n; ++i) visited[i] = false;
+            int* stack = new int[n];
+            int top = 0;
+            stack[top++] = a;
+            visited[a] = true;
+            bool reached = false;
+            while (top > 0 && !reached) {
+                int u = stack[--top];
+                if (u == b) {
+                    reached = true;
+                    break;
+                }
+                DbRecord rec = lazy->record(u);
+                for (int k = 0; k < rec.adjCount; ++k) {
+                    int v = lazy->edge(rec, k).other;
+                    if (!visited[v]) {
+                        visited[v] = true;
+                        stack[top++] = v;
+                    }
+                }
+            }
+            delete[] visited;
+            delete[] stack;
+            if (reached) cout << teamA << " has defeated " << teamB << " (directly or indirectly - via DFS)." << endl;
+            else cout << teamA << " has NOT defeated " << teamB << " (directly or indirectly)." << endl;
+
+            DbRecord recA = lazy->record(a);
+            cout << "Head-to-head: " << teamA << " " << lazyWins(recA, b)
+                 << " - " << lazyLossesTo(recA, b) << " " << teamB << endl;
+        }
+
+        if (a == -1) {
+            cout << "Team not found in the graph." << endl;
+        } else {
+            // Teams it beat (with its losses to them), then teams it only lost to
+            DbRecord recA = lazy->record(a);
+            if (recA.adjCount == 0 && recA.lossCount == 0) cout << teamA << " has not played anyone yet." << endl;
+            for (int k = 0; k < recA.adjCount; ++k) {
+                DbEdge e = lazy->edge(recA, k);
+                cout << teamA << " vs " << lazy->nameOf(e.other) << ": " << e.wins << "-"
+                     << lazyLossesTo(recA, e.other) << endl;
+            }
+            for (int k = 0; k < recA.lossCount; ++k) {
+                DbEdge e = lazy->loss(recA, k);
+                if (lazyWins(recA, e.other) > 0) continue;
+                cout << teamA << " vs " << lazy->nameOf(e.other) << ": 0-" << e.wins << endl;
+            }
+        }
+        firstTouch(3, start);
+    }
+
+    // Graph-free teamAt: the saved leaderboard is sorted by rating, so the
+    // rank is a binary search over it
+    void lazyTeamAt(const string& name, int round) {
+        int id = lazy->findRecord(name);
+        if (id == -1) {
+            cout << name << " was not registered after round " << round << "." << endl;
+            return;
+        }
+        float rating = lazy->record(id).rating;
+        int lo = 0, hi = lazy->header.teamCount; // First team not rated above it
+        while (lo < hi) {
+            int mid = lo + (hi - lo) / 2;
+            if (lazy->record(lazy->leaderboardId(mid)).rating > rating) lo = mid + 1;
+            else hi = mid;
+        }
+        cout << name << " after round " << round << ": Rating " << rating
+             << " | Rank " << lo + 1 << endl;
+    }
+
+    // Top of the saved leaderboard without loading the field
+    bool lazyLeaderboard(int limit) {
+        if (!lazy || lazyDirty) return false;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        int n = lazy->header.teamCount;
+        int shown = limit < n ? limit : n;
+        cout << endl << "=== LEADERBOARD (Top " << shown << " of " << n << ", from disk) ===" << endl;
+        for (int rank = 0; rank < shown; ++rank) {
+            DbRecord rec = lazy->record(lazy->leaderboardId(rank));
+            Team t(lazy->nameOf(rec), rec.rating);
+            t.wins = rec.wins;
+            t.losses = rec.losses;
+            t.show();
+        }
+        firstTouch(2, start);
+        cout << "======================================" << endl;
+        return true;
+    }
+
+    /* ----- DISTRIBUTION TRACKING ----- */
+    // Call forgetStats before changing a team and trackStats after
+    void trackStats(const Team& t) {
+        ratingDist.add(t.rating);
+        if (t.wins + t.losses > 0) winRateDist.add((double)t.wins / (t.wins + t.losses));
+    }
+
+    void forgetStats(const Team& t) {
+        ratingDist.remove(t.rating);
+        if (t.wins + t.losses > 0) winRateDist.remove((double)t.wins / (t.wins + t.losses));
+    }
+
+    /* ----- REGISTRATION ----- */
+    void registerTeam(string n, float r) {
+        if (lookupTeam(n)) { 
+            cout << "Team already exists." << endl;
+            return;
+        }
+        Team newTeam(n,r);
+        teamsHT.insert(newTeam); 
+        trackStats(newTeam);
+        teamsLL.addTeam(newTeam); 
+        performanceGraph.addTeam(n); 
+        history.record(performanceGraph.indexOf(n), currentRound, r);
+        nameSearch.insert(n);
+        lazyDirty = true;
+        cout << n << " registered successfully." << endl;
+    }
+
+    /* ----- SHOW TEAMS ----- */
+    void showTeams() {
+        requireAll();
+        cout << endl << "=== REGISTERED TEAMS ===" << endl;
+        teamsLL.showAll();
+        cout << "=========================" << endl;
+    }
+
+    /* ----- PREDICTION SYSTEM ----- */
+    void predictWinner() {
+        if (lazyClean()) { // The saved leaderboard already knows the top team
+            cout << endl << "=== WINNER PREDICTION SYSTEM ===" << endl;
+            if (lazy->header.teamCount < 2) cout << "Not enough teams for prediction." << endl;
+            else {
+                cout << "Prediction based on current max rating: " << lazy->nameOf(lazy->leaderboardId(0)) << endl;
+                cout << "================================" << endl;
+            }
+            return;
+        }
+        requireAll();
+        cout << endl << "=== WINNER PREDICTION SYSTEM ===" << endl;
+        if (teamsLL.countTeams() < 2) {
+            cout << "Not enough teams for prediction." << endl;
+            return;
+        }
+        
+        // Simple prediction based on current top rating
+        Team* currentMax = NULL;
+        teamsHT.toArray(allTeamsArray, currentTeamCount); 
+        for (int i = 0; i < currentTeamCount; ++i) {
+            if (!currentMax || allTeamsArray[i].rating > currentMax->rating) {
+                currentMax = &allTeamsArray[i];
+            }
+        }
+
+        if (currentMax) {
+            cout << "Prediction based on current max rating: " << currentMax->name << endl;
+        }
+        cout << "================================" << endl;
     }
 
     /* ----- SCHEDULE MATCHES ----- */
     void schedule() {
+        requireAll();
         matches.clear();
         teamsHT.toArray(allTeamsArray, currentTeamCount); 
         
@@ -655,7 +4257,8 @@ public:
             return;
         }
 
-        cout << endl << "=== MATCH SIMULATION ===" << endl;
+        currentRound++;
+        cout << endl << "=== MATCH SIMULATION (Round " << currentRound << ") ===" << endl;
 
         while (!matches.empty()) {
             Team t1 = matches.dequeue();
@@ -666,37 +4269,42 @@ public:
                 w = teamsHT.find(t1.name); 
 
                 if (w) {
+                    forgetStats(*w);
                     w->wins++;
                     w->rating += ratingBonus;
+                    trackStats(*w);
                     cout << w->name << " gets a BYE (wins automatically)." << endl;
                     results.insert(w->name, "bye"); 
                     undo.push(w->name, "bye", ratingBonus); 
+                    history.record(performanceGraph.indexOf(w->name), currentRound, w->rating);
                 }
                 break;
             }
 
             Team t2 = matches.dequeue();
 
-            // rating-based win probability
-            float total = t1.rating + t2.rating;
-            if (total <= 0) total = 1;
-            float prob = t1.rating / total; 
-            string W_name = ((float)rand() / RAND_MAX < prob) ? t1.name : t2.name;
-            string L_name = (W_name == t1.name ? t2.name : t1.name);
-            
-            w = teamsHT.find(W_name); 
-            l = teamsHT.find(L_name); 
-
-            if (w && l) {
-                w->wins++;
-                w->rating += ratingBonus;
-                l->losses++;
+            Team* a = teamsHT.find(t1.name);
+            Team* b = teamsHT.find(t2.name);
+
+            if (a && b) {
+                forgetStats(*a);
+                forgetStats(*b);
+                // rating-based win probability, bonus applied by the rule
+                StdRng rng; // rand(), seeded in main
+                bool firstWins = RatingRule::play(rng, *a, *b);
+                w = firstWins ? a : b;
+                l = firstWins ? b : a;
+                string W_name = w->name;
+                string L_name = l->name;
+                trackStats(*w);
+                trackStats(*l);
 
                 cout << W_name << " defeated " << L_name << endl;
 
                 results.insert(W_name, L_name); 
                 performanceGraph.addMatch(W_name, L_name); 
                 undo.push(W_name, L_name, ratingBonus); 
+                history.record(performanceGraph.indexOf(W_name), currentRound, w->rating);
             }
         }
 
@@ -704,6 +4312,140 @@ public:
         cout << "=========================" << endl;
     }
 
+    /* ----- PIPELINED ROUND ----- */
+    // Stage 1: seed the field through the MaxHeap and stream out pairs
+    void pairingStage(SpscRing<PipelinePair>* out, StageMetrics* m) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        MaxHeap maxHeap(currentTeamCount);
+        for (int i = 0; i < currentTeamCount; ++i) maxHeap.insert(allTeamsArray[i]);
+
+        PipelinePair p;
+        while (!maxHeap.empty()) {
+            p.a = maxHeap.extractMax();
+            p.bye = maxHeap.empty();
+            if (!p.bye) p.b = maxHeap.extractMax();
+            out->push(p);
+            m->items++;
+        }
+        out->close();
+        m->seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        m->blockedOnOutput = out->fullWaits;
+    }
+
+    // Stage 2: decide each match with the model simulate() uses; the commit
+    // stage applies it with the same RatingRule
+    void outcomeStage(SpscRing<PipelinePair>* in, SpscRing<PipelineResult>* out, StageMetrics* m) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        PipelinePair p;
+        PipelineResult r;
+        r.ratingChange = ratingBonus;
+        StdRng rng; // Only this stage draws while the round runs
+        while (in->pop(p)) {
+            if (p.bye) {
+                r.winner = p.a.name;
+                r.loser = "bye";
+            } else {
+                bool firstWins = firstTeamWins(rng, p.a.rating, p.b.rating);
+                r.winner = firstWins ? p.a.name : p.b.name;
+                r.loser = firstWins ? p.b.name : p.a.name;
+            }
+            out->push(r);
+            m->items++;
+        }
+        out->close();
+        m->seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        m->blockedOnOutput = out->fullWaits;
+        m->waitedOnInput = in->emptyWaits;
+    }
+
+    // Stage 3: the only stage that touches teamsHT
+    void commitStage(SpscRing<PipelineResult>* in, SpscRing<PipelineResult>* out, StageMetrics* m) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        PipelineResult r;
+        while (in->pop(r)) {
+            Team* w = teamsHT.find(r.winner);
+            Team* l = (r.loser == "bye") ? NULL : teamsHT.find(r.loser);
+            if (!w || (r.loser != "bye" && !l)) continue;
+            forgetStats(*w);
+            if (l) forgetStats(*l);
+            if (l) {
+                RatingRule::apply(*w, *l);
+            } else {
+                w->wins++;
+                w->rating += r.ratingChange;
+            }
+            trackStats(*w);
+            if (l) trackStats(*l);
+            r.winnerRating = w->rating;
+            out->push(r);
+            m->items++;
+        }
+        out->close();
+        m->seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        m->blockedOnOutput = out->fullWaits;
+        m->waitedOnInput = in->emptyWaits;
+    }
+
+    // Stage 4: results BST, graph, undo journal and rating history
+    void journalStage(SpscRing<PipelineResult>* in, StageMetrics* m) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        PipelineResult r;
+        while (in->pop(r)) {
+            results.insert(r.winner, r.loser);
+            if (r.loser == "bye") {
+                cout << r.winner << " gets a BYE (wins automatically)." << endl;
+            } else {
+                performanceGraph.addMatch(r.winner, r.loser);
+                cout << r.winner << " defeated " << r.loser << endl;
+            }
+            undo.push(r.winner, r.loser, r.ratingChange);
+            history.record(performanceGraph.indexOf(r.winner), currentRound, r.winnerRating);
+            m->items++;
+        }
+        m->seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        m->waitedOnInput = in->emptyWaits;
+    }
+
+    // Schedule + simulate in one streaming pass, each stage on its own thread
+    void runRoundPipelined() {
+        requireAll();
+        teamsHT.toArray(allTeamsArray, currentTeamCount);
+        if (currentTeamCount < 2) {
+            cout << "Need at least 2 teams to schedule matches." << endl;
+            return;
+        }
+        matches.clear(); // A pipelined round replaces any pending schedule
+
+        const int RING_SIZE = 1024;
+        SpscRing<PipelinePair> pairs(RING_SIZE);
+        SpscRing<PipelineResult> outcomes(RING_SIZE);
+        SpscRing<PipelineResult> committed(RING_SIZE);
+        StageMetrics metrics[4];
+        metrics[0].name = "Pairing";
+        metrics[1].name = "Outcome";
+        metrics[2].name = "Commit";
+        metrics[3].name = "Journal";
+
+        currentRound++;
+        cout << endl << "=== PIPELINED ROUND " << currentRound << " ===" << endl;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+        thread s1(&Tournament::pairingStage, this, &pairs, &metrics[0]);
+        thread s2(&Tournament::outcomeStage, this, &pairs, &outcomes, &metrics[1]);
+        thread s3(&Tournament::commitStage, this, &outcomes, &committed, &metrics[2]);
+        thread s4(&Tournament::journalStage, this, &committed, &metrics[3]);
+        s1.join();
+        s2.join();
+        s3.join();
+        s4.join();
+
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        cout << "--- Stage metrics ---" << endl;
+        for (int i = 0; i < 4; ++i) metrics[i].show();
+        cout << "Round streamed in " << ms << " ms" << endl;
+        cout << "=================================" << endl;
+    }
+
     /* ----- UNDO LAST MATCH ----- */
     void undoLast() {
         if (undo.empty()) {
@@ -717,17 +4459,27 @@ public:
         Team* l = (r.loser == "bye") ? NULL : teamsHT.find(r.loser);
 
         if (w) {
+            forgetStats(*w);
             w->wins--;
             w->rating -= r.ratingChange;
+            trackStats(*w);
+            history.record(performanceGraph.indexOf(w->name), currentRound, w->rating);
         }
 
-        if (l) l->losses--;
+        if (l) {
+            forgetStats(*l);
+            l->losses--;
+            trackStats(*l);
+            performanceGraph.removeMatch(r.winner, r.loser);
+        }
 
         cout << "Undo complete: " << r.winner << " vs " << r.loser << endl;
     }
 
     /* ----- LEADERBOARD ----- */
     void leaderboard() {
+        if (lazyLeaderboard(20)) return;
+        requireAll();
         teamsHT.toArray(allTeamsArray, currentTeamCount); 
 
         if (currentTeamCount == 0) {
@@ -746,6 +4498,7 @@ public:
 
     /* ----- RESULTS ----- */
     void showResults() {
+        requireAll();
         cout << endl << "=== MATCH RESULTS (BST) ===" << endl;
         results.show();
         cout << "===========================" << endl;
@@ -753,23 +4506,522 @@ public:
     
     /* ----- PERFORMANCE TRACKING ----- */
     void showPerformance() {
-        performanceGraph.showGraph();
+        bool onDisk = lazyClean();
+        if (onDisk) {
+            cout << endl << "[Lazy] Graph not loaded; only the teams asked about are read from disk." << endl;
+        } else {
+            requireAll();
+            performanceGraph.showGraph();
+        }
         string teamA, teamB;
         cout << "Check for indirect win. Team A: ";
         cin.ignore();
         getline(cin, teamA);
         cout << "Team B: ";
         getline(cin, teamB);
+        if (onDisk) {
+            lazyPerformance(teamA, teamB);
+            return;
+        }
         performanceGraph.checkIndirectWin(teamA, teamB); 
+        performanceGraph.showHeadToHead(teamA, teamB);
+        performanceGraph.showOpponents(teamA);
+    }
+
+    /* ----- POWER RANKING ----- */
+    void powerRanking() {
+        requireAll();
+        if (performanceGraph.size() == 0) {
+            cout << "No teams." << endl;
+            return;
+        }
+        bool warm = ranker.hasSolution();
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        int iterations = ranker.rank(performanceGraph, true);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        cout << endl << "=== POWER RANKING (Defeat Graph) ===" << endl;
+        ranker.showTop(performanceGraph, 10);
+        cout << (warm ? "Warm" : "Cold") << " solve: " << iterations
+             << " iterations in " << ms << " ms" << endl;
+        cout << "====================================" << endl;
+    }
+
+    /* ----- RATING HISTORY ----- */
+    void leaderboardAt(int round) {
+        int n = performanceGraph.size();
+        Team* snapshot = new Team[n > 0 ? n : 1];
+        int count = 0;
+        float rating;
+        for (int i = 0; i < n; ++i) {
+            if (history.ratingAt(i, round, rating)) {
+                snapshot[count++] = Team(performanceGraph.nameAt(i), rating);
+            }
+        }
+        if (count == 0) {
+            cout << "No teams existed after round " << round << "." << endl;
+            delete[] snapshot;
+            return;
+        }
+        mergeSort(snapshot, 0, count - 1);
+
+        cout << endl << "=== LEADERBOARD AFTER ROUND " << round << " ===" << endl;
+        for (int i = 0; i < count; ++i) {
+            cout << i + 1 << ". " << snapshot[i].name << " | Rating: " << snapshot[i].rating << endl;
+        }
+        cout << "======================================" << endl;
+        delete[] snapshot;
+    }
+
+    void teamAt(const string& name, int round) {
+        int id = performanceGraph.indexOf(name);
+        float rating;
+        if (id == -1 || !history.ratingAt(id, round, rating)) {
+            cout << name << " was not registered after round " << round << "." << endl;
+            return;
+        }
+        int rank = 1;
+        float other;
+        for (int i = 0; i < performanceGraph.size(); ++i) {
+            if (i != id && history.ratingAt(i, round, other) && other > rating) rank++;
+        }
+        cout << name << " after round " << round << ": Rating " << rating
+             << " | Rank " << rank << endl;
+    }
+
+    void showHistory() {
+        int round;
+        string name;
+        cout << "Round (" << historyStart << "-" << currentRound << "): ";
+        cin >> round;
+        if (cin.fail()) {
+            cin.clear();
+            cin.ignore(1000, '\n');
+            cout << "Invalid round." << endl;
+            return;
+        }
+        if (round < historyStart) {
+            cin.ignore(1000, '\n');
+            cout << "No history before round " << historyStart
+                 << " (history starts at this session)." << endl;
+            return;
+        }
+        cin.ignore();
+        cout << "Team name (leave blank for full leaderboard): ";
+        getline(cin, name);
+
+        if (!name.empty() && lazyClean()) {
+            lazyTeamAt(name, round);
+            return;
+        }
+        requireAll();
+        if (name.empty()) leaderboardAt(round);
+        else teamAt(name, round);
+
+        cout << "[History] " << history.events() << " rating changes in "
+             << history.bytesUsed() << " bytes." << endl;
+    }
+
+    /* ----- TEAM SEARCH ----- */
+    void searchTeams() {
+        const int LIMIT = 10;
+        string query;
+        cin.ignore();
+        cout << "Search: ";
+        getline(cin, query);
+
+        string matches[LIMIT];
+        int dists[LIMIT];
+
+        bool onDisk = lazyClean(); // Prefixes are a range of the saved name index
+        if (!onDisk) requireNames();
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        int found = onDisk ? lazy->prefixSearch(query, matches, LIMIT)
+                           : nameSearch.prefixSearch(query, matches, LIMIT);
+        double us = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+
+        cout << endl << "=== TEAMS STARTING WITH \"" << query << "\" ===" << endl;
+        if (found == 0) cout << "No matches." << endl;
+        for (int i = 0; i < found; ++i) cout << matches[i] << endl;
+        cout << "(" << us << " us)" << endl;
+
+        if (found < LIMIT) {
+            requireNames();
+            start = chrono::steady_clock::now();
+            found = nameSearch.fuzzySearch(query, 2, matches, dists, LIMIT);
+            us = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+
+            cout << "=== CLOSE MATCHES (up to 2 edits) ===" << endl;
+            if (found == 0) cout << "No matches." << endl;
+            for (int i = 0; i < found; ++i)
+                cout << matches[i] << " (" << dists[i] << " edits)" << endl;
+            cout << "(" << us << " us)" << endl;
+        }
+        cout << "=====================================" << endl;
+    }
+
+    /* ----- WHAT-IF ANALYSIS ----- */
+    // Print the `limit` most frequent leaders across a set of branches
+    void tallyLeaders(TournamentFork** forks, int forkCount, int limit) {
+        NameIndexMap slots;
+        string* names = new string[forkCount];
+        int* counts = new int[forkCount];
+        int distinct = 0;
+        for (int i = 0; i < forkCount; ++i) {
+            string leader = forks[i]->leader();
+            int slot = slots.get(leader);
+            if (slot == -1) {
+                slot = distinct++;
+                slots.put(leader, slot);
+                names[slot] = leader;
+                counts[slot] = 0;
+            }
+            counts[slot]++;
+        }
+        for (int i = 0; i < distinct && i < limit; ++i) {
+            int best = i;
+            for (int j = i + 1; j < distinct; ++j) if (counts[j] > counts[best]) best = j;
+            swap(names[i], names[best]);
+            swap(counts[i], counts[best]);
+            cout << "  " << names[i] << ": " << (100.0 * counts[i] / forkCount) << "%" << endl;
+        }
+        delete[] names;
+        delete[] counts;
+    }
+
+    void whatIf() {
+        requireAll();
+        string winner, loser;
+        int branches, rounds;
+        cin.ignore();
+        cout << "What if this team had won: ";
+        getline(cin, winner);
+        cout << "Against: ";
+        getline(cin, loser);
+        cout << "Branches per scenario: ";
+        cin >> branches;
+        cout << "Rounds to simulate forward: ";
+        cin >> rounds;
+        if (cin.fail() || branches < 1 || rounds < 0) {
+            cin.clear();
+            cin.ignore(1000, '\n');
+            cout << "Invalid input." << endl;
+            return;
+        }
+        if (!teamsHT.find(winner) || !teamsHT.find(loser)) {
+            cout << "One or both teams not found." << endl;
+            return;
+        }
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        ForkBase base(teamsHT);
+        TournamentFork actual(&base, (unsigned int)rand());
+        TournamentFork* hypothetical = actual.fork((unsigned int)rand());
+
+        // Flip a real result if there is one, otherwise just add the win
+        if (performanceGraph.headToHeadWins(loser, winner) > 0)
+            hypothetical->revertResult(loser, winner, ratingBonus);
+        hypothetical->applyResult(winner, loser, ratingBonus);
+
+        TournamentFork** forks = new TournamentFork*[2 * branches];
+        for (int i = 0; i < branches; ++i) {
+            forks[i] = actual.fork((unsigned int)rand());
+            forks[branches + i] = hypothetical->fork((unsigned int)rand());
+        }
+        runForksInParallel(forks, 2 * branches, rounds, ratingBonus);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        cout << endl << "=== WHAT-IF: " << winner << " beats " << loser << " ===" << endl;
+        cout << "Leader after " << rounds << " more round(s), as it stands:" << endl;
+        tallyLeaders(forks, branches, 5);
+        cout << "Leader after " << rounds << " more round(s), if " << winner << " had won:" << endl;
+        tallyLeaders(forks + branches, branches, 5);
+        cout << 2 * branches << " branches in " << ms << " ms (real tournament untouched)" << endl;
+        cout << "======================================" << endl;
+
+        for (int i = 0; i < 2 * branches; ++i) delete forks[i];
+        delete[] forks;
+        delete hypothetical;
+    }
+
+    /* ----- EXTERNAL-MEMORY MODE ----- */
+    // Leaderboard + seeded pairings for fields too big for RAM. Streams
+    // teams.txt into a paged store, sorts it externally, then streams pairs.
+    void externalLeaderboard() {
+        long long limitMB;
+        cout << "[External] Reads teams.txt as last saved; unsaved registrations and results are not included." << endl;
+        cout << "Memory limit for team data (MB): ";
+        cin >> limitMB;
+        if (cin.fail() || limitMB < 1) {
+            cin.clear();
+            cin.ignore(1000, '\n');
+            cout << "Invalid limit." << endl;
+            return;
+        }
+        long long budget = limitMB * 1024 * 1024;
+
+        ifstream f("teams.txt");
+        if (!f.is_open()) {
+            cout << "[External] teams.txt not found." << endl;
+            return;
+        }
+
+        // RSS is process-wide, so the run is measured against where it started
+        double rssBefore = currentRssMB();
+        double peakBefore = peakRssMB();
+        long long truncated = 0;
+        long long workingSet = 0;
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        {
+            // A quarter of the budget for the buffer pool, the rest for sorting
+            PagedTeamStore store("teams.pages", budget / 4);
+            if (!store.ok()) {
+                cout << "[External] Error: Could not create teams.pages!" << endl;
+                return;
+            }
+
+            string n;
+            float r;
+            int w, l;
+            while (getline(f, n)) {
+                if (n.empty()) continue;
+                if (!(f >> r >> w >> l)) break;
+                f.ignore(1000, '\n');
+                DiskTeam d = makeDiskTeam(n, r, w, l);
+                if (n.size() > sizeof(d.name) - 1) truncated++;
+                store.append(d);
+            }
+            store.flush();
+
+            ExternalSorter sorter(budget - store.poolBytes());
+            workingSet = store.poolBytes() + sorter.memoryBytes();
+            sorter.sort(store, "leaderboard.bin");
+
+            cout << "[External] " << store.size() << " teams | pool "
+                 << store.poolBytes() / 1024 << " KB (" << store.hits() << " hits, "
+                 << store.misses() << " misses, " << store.evictions() << " evictions) | "
+                 << sorter.runsWritten << " runs, " << sorter.mergePasses << " merge passes" << endl;
+        }
+        remove("teams.pages");
+
+        // Stream the sorted file: top 10, then pairs of adjacent seeds
+        ifstream sorted("leaderboard.bin", ios::binary);
+        ofstream pairs("pairings.txt");
+        cout << endl << "=== LEADERBOARD (External Sort, Top 10) ===" << endl;
+
+        DiskTeam cur, pending;
+        bool hasPending = false;
+        long long seed = 0, match = 0;
+        while (sorted.read((char*)&cur, sizeof(DiskTeam))) {
+            seed++;
+            if (seed <= 10) {
+                cout << seed << ". " << cur.name << " | Rating: " << cur.rating
+                     << " | W-L: " << cur.wins << "-" << cur.losses << endl;
+            }
+            if (!hasPending) {
+                pending = cur;
+                hasPending = true;
+            } else {
+                pairs << "Match " << ++match << ": " << pending.name << " (Seed " << seed - 1
+                      << ") vs " << cur.name << " (Seed " << seed << ")" << endl;
+                hasPending = false;
+            }
+        }
+        if (hasPending) pairs << "Match " << ++match << ": " << pending.name << " gets a BYE" << endl;
+
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        cout << match << " pairings written to pairings.txt in " << ms << " ms" << endl;
+        if (truncated > 0)
+            cout << "[External] Warning: " << truncated << " team name(s) longer than "
+                 << sizeof(cur.name) - 1 << " characters are truncated in leaderboard.bin and pairings.txt." << endl;
+        if (workingSet > budget)
+            cout << "[External] Warning: the limit is below the minimum working set ("
+                 << workingSet / 1024 << " KB); the minimum was used." << endl;
+
+        double peak = peakRssMB();
+        cout << "Peak RSS: " << peak << " MB";
+        if (peak > peakBefore && rssBefore > 0) {
+            // This run set a new peak, so its growth over the starting RSS is known
+            double grew = peak - rssBefore;
+            cout << " (+" << grew << " MB during this run)";
+            if (grew > limitMB) cout << endl << "[External] Warning: memory limit of " << limitMB
+                                     << " MB exceeded by " << grew - limitMB << " MB.";
+        }
+        cout << endl;
+        cout << "===========================================" << endl;
+    }
+
+    /* ----- DISTRIBUTION DASHBOARD ----- */
+    void showDistribution() {
+        requireStats();
+        if (ratingDist.count() == 0) {
+            cout << "No teams." << endl;
+            return;
+        }
+        cout << endl << "=== RATING DISTRIBUTION ===" << endl;
+        cout << "Teams: " << ratingDist.count() << " | Mean: " << ratingDist.mean()
+             << " | Std dev: " << ratingDist.stddev() << endl;
+        cout << "p50: " << ratingDist.quantile(0.5) << " | p90: " << ratingDist.quantile(0.9)
+             << " | p99: " << ratingDist.quantile(0.99) << endl;
+        ratingDist.showBands(10);
+
+        cout << "--- Win rate (teams with games) ---" << endl;
+        if (winRateDist.count() == 0) cout << "No games played yet." << endl;
+        else {
+            cout << "Teams: " << winRateDist.count() << " | Mean: " << winRateDist.mean()
+                 << " | p50: " << winRateDist.quantile(0.5) << " | p90: " << winRateDist.quantile(0.9)
+                 << " | p99: " << winRateDist.quantile(0.99) << endl;
+        }
+
+        string name;
+        cin.ignore();
+        cout << "Percentile of team (leave blank to skip): ";
+        getline(cin, name);
+        if (!name.empty()) {
+            Team* t = lookupTeam(name);
+            if (!t) cout << "Team not found." << endl;
+            else {
+                cout << name << " | Rating percentile: " << ratingDist.percentileOf(t->rating);
+                if (t->wins + t->losses > 0)
+                    cout << " | Win-rate percentile: "
+                         << winRateDist.percentileOf((double)t->wins / (t->wins + t->losses));
+                cout << endl;
+            }
+        }
+        cout << "===========================" << endl;
+    }
+
+    /* ----- GROUP STAGE ----- */
+    void groupStage() {
+        requireAll();
+        int groupCount, advance;
+        cout << "Number of groups: ";
+        cin >> groupCount;
+        cout << "Teams advancing per group: ";
+        cin >> advance;
+        if (cin.fail() || groupCount < 1 || advance < 1) {
+            cin.clear();
+            cin.ignore(1000, '\n');
+            cout << "Invalid input." << endl;
+            return;
+        }
+
+        teamsHT.toArray(allTeamsArray, currentTeamCount);
+        if (currentTeamCount < 2 * groupCount) {
+            cout << "Need at least 2 teams per group." << endl;
+            return;
+        }
+        long long perGroup = (currentTeamCount + groupCount - 1) / groupCount;
+        if (Group::matchesFor(perGroup) > Group::MAX_MATCHES) {
+            cout << "Groups of " << perGroup << " teams are too large for a round robin"
+                 << " (at most " << Group::MAX_MATCHES << " matches per group); use more groups." << endl;
+            return;
+        }
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        GroupStage stage(allTeamsArray, currentTeamCount, groupCount);
+        stage.run(ratingBonus);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        cout << endl << "=== GROUP STAGE (" << groupCount << " groups) ===" << endl;
+        int* order = new int[stage.groups[0].capacity];
+        for (int g = 0; g < groupCount && g < 8; ++g) { // Tables for the first few groups
+            Group& grp = stage.groups[g];
+            grp.standings(order, stage.startWins[g]);
+            cout << "Group " << g + 1 << ":" << endl;
+            for (int i = 0; i < grp.count; ++i) {
+                const Team& t = grp.teams[order[i]];
+                cout << "  " << i + 1 << ". " << t.name << " | Group W: "
+                     << t.wins - stage.startWins[g][order[i]] << " | Rating: " << t.rating
+                     << (i < advance ? "  (advances)" : "") << endl;
+            }
+        }
+        if (groupCount > 8) cout << "... " << groupCount - 8 << " more groups" << endl;
+        delete[] order;
+
+        long long played = 0;
+        for (int g = 0; g < groupCount; ++g) played += stage.groups[g].resultCount;
+        cout << played << " group matches played in " << ms << " ms" << endl;
+
+        Team* seeds = new Team[groupCount * advance];
+        int seeded = stage.seeding(advance, seeds);
+        cout << "--- Knockout seeding ---" << endl;
+        for (int i = 0; i < seeded && i < 16; ++i)
+            cout << "Seed " << i + 1 << ": " << seeds[i].name << endl;
+        if (seeded > 16) cout << "... " << seeded - 16 << " more seeds" << endl;
+
+        char ch;
+        cout << "Commit group results and queue the knockout round? (y/n): ";
+        cin >> ch;
+        if (ch == 'y' || ch == 'Y') {
+            commitGroupStage(stage);
+            queueKnockout(seeds, seeded);
+        } else {
+            cout << "Group stage discarded." << endl;
+        }
+        delete[] seeds;
+        cout << "==================================" << endl;
+    }
+
+    // Serial merge of every group's results into the shared structures
+    void commitGroupStage(GroupStage& stage) {
+        currentRound++;
+        for (int g = 0; g < stage.groupCount; ++g) {
+            Group& grp = stage.groups[g];
+            for (int m = 0; m < grp.resultCount; ++m) {
+                const string& W_name = grp.teams[grp.winners[m]].name;
+                const string& L_name = grp.teams[grp.losers[m]].name;
+                Team* w = teamsHT.find(W_name);
+                Team* l = teamsHT.find(L_name);
+                if (!w || !l) continue;
+                forgetStats(*w);
+                forgetStats(*l);
+                w->wins++;
+                w->rating += ratingBonus;
+                l->losses++;
+                trackStats(*w);
+                trackStats(*l);
+                results.insert(W_name, L_name);
+                performanceGraph.addMatch(W_name, L_name);
+                undo.push(W_name, L_name, ratingBonus);
+                history.record(performanceGraph.indexOf(W_name), currentRound, w->rating);
+            }
+        }
+        cout << "Group results committed as round " << currentRound << "." << endl;
+    }
+
+    // 1 v N, 2 v N-1, ... ready for Simulate Matches
+    void queueKnockout(Team* seeds, int seeded) {
+        matches.clear();
+        for (int i = 0; i < seeded / 2; ++i) {
+            Team* a = teamsHT.find(seeds[i].name);
+            Team* b = teamsHT.find(seeds[seeded - 1 - i].name);
+            if (!a || !b) continue;
+            matches.enqueue(*a);
+            matches.enqueue(*b);
+            cout << "Knockout " << i + 1 << ": " << a->name << " (Seed " << i + 1 << ") vs "
+                 << b->name << " (Seed " << seeded - i << ")" << endl;
+        }
+        if (seeded % 2 == 1) {
+            Team* bye = teamsHT.find(seeds[seeded / 2].name);
+            if (bye) {
+                matches.enqueue(*bye);
+                cout << bye->name << " gets a BYE" << endl;
+            }
+        }
+        cout << "Use 'Simulate Matches' to play the knockout round." << endl;
     }
 
     /* ----- SAVE/LOAD TEAMS ----- */
     void saveTeams() {
+        requireAll();
         // 1. Refresh the internal array so we are saving the latest data
         teamsHT.toArray(allTeamsArray, currentTeamCount);
 
         if (currentTeamCount == 0) {
             cout << "[Save] No teams to save." << endl;
+            remove("teams.db"); // Never leave an index that disagrees with teams.txt
             return;
         }
 
@@ -791,6 +5043,152 @@ public:
         
         f.close();
         cout << "[Save] Success! Data written to teams.txt." << endl;
+        struct stat text;
+        saveDatabase(stat("teams.txt", &text) == 0 ? (long long)text.st_size : -1);
+    }
+
+    // Indexed binary save (teams.db) that openLazy can start from instantly.
+    // `textBytes` is the size of the teams.txt it accompanies.
+    void saveDatabase(long long textBytes) {
+        int n = currentTeamCount;
+        NameIndexMap ids(n * 2);
+        for (int i = 0; i < n; ++i) ids.put(allTeamsArray[i].name, i);
+
+        int* byName = new int[n];
+        int* byRating = new int[n];
+        for (int i = 0; i < n; ++i) byName[i] = byRating[i] = i;
+        sortTeamIds(byName, n, allTeamsArray, true);
+        sortTeamIds(byRating, n, allTeamsArray, false);
+
+        // Defeat edges, regrouped from graph order to record order
+        int *rowStart, *cols;
+        float* weights;
+        performanceGraph.buildCSR(rowStart, cols, weights);
+        int* rowOfRecord = new int[n];
+        for (int i = 0; i < n; ++i) rowOfRecord[i] = performanceGraph.indexOf(allTeamsArray[i].name);
+
+        int resultCount = results.count(results.root);
+        string* winners = new string[resultCount > 0 ? resultCount : 1];
+        string* losers = new string[resultCount > 0 ? resultCount : 1];
+        int collected = 0;
+        results.collect(results.root, winners, losers, collected);
+
+        DbHeader h;
+        memset(&h, 0, sizeof(h));
+        memcpy(h.magic, DB_MAGIC, sizeof(DB_MAGIC));
+        h.teamCount = n;
+        h.round = currentRound;
+        h.resultCount = resultCount;
+        h.textBytes = textBytes;
+        for (int i = 0; i < n; ++i) {
+            int row = rowOfRecord[i];
+            if (row != -1) h.edgeCount += rowStart[row + 1] - rowStart[row];
+        }
+        h.indexOffset = sizeof(DbHeader);
+        h.recordOffset = h.indexOffset + (long long)n * sizeof(DbIndexEntry);
+        h.adjacencyOffset = h.recordOffset + (long long)n * sizeof(DbRecord);
+        h.lossesOffset = h.adjacencyOffset + (long long)h.edgeCount * sizeof(DbEdge);
+        h.leaderboardOffset = h.lossesOffset + (long long)h.edgeCount * sizeof(DbEdge);
+        h.resultsOffset = h.leaderboardOffset + (long long)n * sizeof(int);
+        h.namesOffset = h.resultsOffset + (long long)resultCount * sizeof(DbResult);
+
+        // The same edges grouped by loser: lossStart[i] .. lossStart[i + 1]
+        int* lossStart = new int[n + 1];
+        for (int i = 0; i <= n; ++i) lossStart[i] = 0;
+        for (int i = 0; i < n; ++i) {
+            int row = rowOfRecord[i];
+            if (row == -1) continue;
+            for (int e = rowStart[row]; e < rowStart[row + 1]; ++e)
+                lossStart[ids.get(performanceGraph.nameAt(cols[e])) + 1]++;
+        }
+        for (int i = 0; i < n; ++i) lossStart[i + 1] += lossStart[i];
+        DbEdge* losses = new DbEdge[h.edgeCount > 0 ? h.edgeCount : 1];
+        int* lossFill = new int[n > 0 ? n : 1];
+        for (int i = 0; i < n; ++i) lossFill[i] = lossStart[i];
+        for (int i = 0; i < n; ++i) {
+            int row = rowOfRecord[i];
+            if (row == -1) continue;
+            for (int e = rowStart[row]; e < rowStart[row + 1]; ++e) {
+                int loser = ids.get(performanceGraph.nameAt(cols[e]));
+                losses[lossFill[loser]].other = i;
+                losses[lossFill[loser]].wins = (int)weights[e];
+                lossFill[loser]++;
+            }
+        }
+
+        // Names blob in record order; record i's name starts at nameAt[i]
+        long long* nameAt = new long long[n > 0 ? n : 1];
+        long long nameBytes = 0;
+        for (int i = 0; i < n; ++i) {
+            nameAt[i] = h.namesOffset + nameBytes;
+            nameBytes += allTeamsArray[i].name.size();
+        }
+
+        ofstream f("teams.db", ios::binary | ios::trunc);
+        if (!f.is_open()) {
+            cout << "[Save] Error: Could not create teams.db!" << endl;
+        } else {
+            f.write((const char*)&h, sizeof(h));
+            for (int i = 0; i < n; ++i) {
+                DbIndexEntry e;
+                memset(&e, 0, sizeof(e));
+                e.nameOffset = nameAt[byName[i]];
+                e.nameLength = (int)allTeamsArray[byName[i]].name.size();
+                e.recordId = byName[i];
+                f.write((const char*)&e, sizeof(e));
+            }
+            long long adj = h.adjacencyOffset;
+            for (int i = 0; i < n; ++i) {
+                const Team& t = allTeamsArray[i];
+                DbRecord rec;
+                memset(&rec, 0, sizeof(rec));
+                rec.rating = t.rating;
+                rec.wins = t.wins;
+                rec.losses = t.losses;
+                int row = rowOfRecord[i];
+                rec.adjCount = (row == -1) ? 0 : rowStart[row + 1] - rowStart[row];
+                rec.adjOffset = adj;
+                adj += (long long)rec.adjCount * sizeof(DbEdge);
+                rec.nameOffset = nameAt[i];
+                rec.nameLength = (int)t.name.size();
+                rec.lossOffset = h.lossesOffset + (long long)lossStart[i] * sizeof(DbEdge);
+                rec.lossCount = lossStart[i + 1] - lossStart[i];
+                f.write((const char*)&rec, sizeof(rec));
+            }
+            for (int i = 0; i < n; ++i) {
+                int row = rowOfRecord[i];
+                if (row == -1) continue;
+                for (int e = rowStart[row]; e < rowStart[row + 1]; ++e) {
+                    DbEdge edge;
+                    edge.other = ids.get(performanceGraph.nameAt(cols[e]));
+                    edge.wins = (int)weights[e];
+                    f.write((const char*)&edge, sizeof(edge));
+                }
+            }
+            f.write((const char*)losses, (long long)h.edgeCount * sizeof(DbEdge));
+            f.write((const char*)byRating, (long long)n * sizeof(int));
+            for (int i = 0; i < resultCount; ++i) {
+                DbResult r;
+                r.winner = ids.get(winners[i]);
+                r.loser = (losers[i] == "bye") ? -1 : ids.get(losers[i]);
+                f.write((const char*)&r, sizeof(r));
+            }
+            for (int i = 0; i < n; ++i) f.write(allTeamsArray[i].name.data(), allTeamsArray[i].name.size());
+            cout << "[Save] Indexed copy written to teams.db (lazy startup)." << endl;
+        }
+
+        delete[] byName;
+        delete[] byRating;
+        delete[] nameAt;
+        delete[] lossStart;
+        delete[] lossFill;
+        delete[] losses;
+        delete[] rowStart;
+        delete[] cols;
+        delete[] weights;
+        delete[] rowOfRecord;
+        delete[] winners;
+        delete[] losers;
     }
 
    void loadTeams() {
@@ -806,7 +5204,13 @@ public:
         int loadedCount = 0;
         
         // Clear existing data to avoid duplicates
+        closeLazy(); // teams.txt replaces the lazily opened save
         teamsLL.clear(); 
+        if (history.events() == 0) restoreRound(savedRound("teams.db")); // Same round as openLazy
+
+        // Names are gathered and the search trie is bulk-built once at the end
+        int nameCapacity = 64;
+        string* loadedNames = new string[nameCapacity];
         
         cout << "[Load] Reading file..." << endl;
 
@@ -829,25 +5233,47 @@ public:
             t.losses = l;
             
             teamsLL.addTeam(t);
+            Team* existing = teamsHT.find(n);
+            if (existing) forgetStats(*existing); // Reloading replaces it
             teamsHT.insert(t);
+            trackStats(t);
             performanceGraph.addTeam(n); // Ensure graph knows about the team
+            history.record(performanceGraph.indexOf(n), currentRound, r);
+            if (loadedCount == nameCapacity) {
+                string* bigger = new string[nameCapacity * 2];
+                for (int i = 0; i < loadedCount; ++i) bigger[i].swap(loadedNames[i]);
+                delete[] loadedNames;
+                loadedNames = bigger;
+                nameCapacity *= 2;
+            }
+            loadedNames[loadedCount] = n;
             
             loadedCount++;
         }
         
         f.close();
+        nameSearch.build(loadedNames, loadedCount);
+        delete[] loadedNames;
         cout << "[Load] Success! Loaded " << loadedCount << " teams." << endl;
     }
 };
 
 
-int main() {
+int main(int argc, char* argv[]) {
     srand(time(0));
 
     Tournament t;
+
+    // Fields larger than RAM: "--external" runs the external-memory
+    // leaderboard straight from teams.txt, without loading it into memory
+    if (argc > 1 && strcmp(argv[1], "--external") == 0) {
+        t.externalLeaderboard();
+        return 0;
+    }
     
     // Auto-load on startup (optional, you can remove this line if you ONLY want manual load)
-    t.loadTeams(); 
+    // Prefer the indexed save: it opens instantly and loads teams on demand
+    if (!t.openLazy("teams.db")) t.loadTeams(); 
     
     int c;
 
@@ -865,6 +5291,16 @@ int main() {
         cout << "9.  Predict Winner" << endl;
         cout << "10. Save Teams to File" << endl; // NEW OPTION
         cout << "11. Load Teams from File" << endl; // NEW OPTION
+        cout << "12. Benchmark Parallel Ingestion" << endl;
+        cout << "13. Power Ranking" << endl;
+        cout << "14. Rating History" << endl;
+        cout << "15. Search Teams" << endl;
+        cout << "16. What-If Analysis" << endl;
+        cout << "17. External-Memory Leaderboard" << endl;
+        cout << "18. Run Round (Pipelined)" << endl;
+        cout << "19. Benchmark Specialized Builds" << endl;
+        cout << "20. Rating Distribution" << endl;
+        cout << "21. Group Stage" << endl;
         cout << "0.  Exit" << endl;
         cout << "Enter Choice: ";
 
@@ -910,6 +5346,18 @@ int main() {
             cout << "Warning: Loading will overwrite unsaved current data." << endl;
             t.loadTeams();
         }
+        else if (c == 12) {
+            benchmarkConcurrentIngestion(10000, 200000);
+        }
+        else if (c == 13) t.powerRanking();
+        else if (c == 14) t.showHistory();
+        else if (c == 15) t.searchTeams();
+        else if (c == 16) t.whatIf();
+        else if (c == 17) t.externalLeaderboard();
+        else if (c == 18) t.runRoundPipelined();
+        else if (c == 19) benchmarkSpecializedEngines();
+        else if (c == 20) t.showDistribution();
+        else if (c == 21) t.groupStage();
         // -------------------
 
         else if (c == 0) {